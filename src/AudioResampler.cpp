@@ -0,0 +1,102 @@
+#include "AudioResampler.h"
+
+#include <samplerate.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+int converterType(ResampleQuality quality) {
+  switch (quality) {
+    case ResampleQuality::Best:
+      return SRC_SINC_BEST_QUALITY;
+    case ResampleQuality::Medium:
+      return SRC_SINC_MEDIUM_QUALITY;
+    case ResampleQuality::Fastest:
+      return SRC_SINC_FASTEST;
+    case ResampleQuality::Linear:
+      return SRC_LINEAR;
+  }
+  return SRC_SINC_MEDIUM_QUALITY;
+}
+
+// Output frames requested per src_process() call when draining the filter tail.
+constexpr long kFlushFrames = 1024;
+}  // namespace
+
+StreamResampler::~StreamResampler() {
+  if (state_) {
+    src_delete(state_);
+  }
+}
+
+bool StreamResampler::init(int channels, int inputRate, int outputRate, ResampleQuality quality, std::string& err) {
+  if (state_) {
+    src_delete(state_);
+    state_ = nullptr;
+  }
+  if (channels <= 0 || inputRate <= 0 || outputRate <= 0) {
+    err = "Invalid resampler format.";
+    return false;
+  }
+  channels_ = channels;
+  ratio_ = static_cast<double>(outputRate) / static_cast<double>(inputRate);
+  if (inputRate == outputRate) {
+    return true;
+  }
+  int error = 0;
+  state_ = src_new(converterType(quality), channels, &error);
+  if (!state_) {
+    err = std::string("Failed to create resampler: ") + src_strerror(error);
+    return false;
+  }
+  return true;
+}
+
+bool StreamResampler::process(const float* input, long frames, std::vector<float>& out, std::string& err) {
+  if (!input || frames <= 0) {
+    return true;
+  }
+  if (!state_) {
+    out.insert(out.end(), input, input + static_cast<size_t>(frames) * static_cast<size_t>(channels_));
+    return true;
+  }
+  return run(input, frames, false, out, err);
+}
+
+bool StreamResampler::finish(std::vector<float>& out, std::string& err) {
+  if (!state_) {
+    return true;
+  }
+  return run(nullptr, 0, true, out, err);
+}
+
+bool StreamResampler::run(const float* input, long frames, bool endOfInput, std::vector<float>& out, std::string& err) {
+  SRC_DATA data{};
+  data.data_in = input;
+  data.input_frames = frames;
+  data.end_of_input = endOfInput ? 1 : 0;
+  data.src_ratio = ratio_;
+  while (true) {
+    // Room for this chunk's share of output plus slack for the filter's buffered frames.
+    const long capacity = std::max(kFlushFrames, static_cast<long>(std::ceil(static_cast<double>(data.input_frames) * ratio_)) + 16);
+    const size_t base = out.size();
+    out.resize(base + static_cast<size_t>(capacity) * static_cast<size_t>(channels_));
+    data.data_out = out.data() + base;
+    data.output_frames = capacity;
+    const int error = src_process(state_, &data);
+    out.resize(base + static_cast<size_t>(data.output_frames_gen) * static_cast<size_t>(channels_));
+    if (error != 0) {
+      err = std::string("Resampling failed: ") + src_strerror(error);
+      return false;
+    }
+    data.data_in += data.input_frames_used * channels_;
+    data.input_frames -= data.input_frames_used;
+    if (data.input_frames > 0) {
+      continue;
+    }
+    if (!endOfInput || data.output_frames_gen == 0) {
+      return true;
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct SRC_STATE_tag;
+
+// Converter choice for recording; maps onto the libsamplerate converter types.
+enum class ResampleQuality {
+  Best,
+  Medium,
+  Fastest,
+  Linear,
+};
+
+// Streaming sample-rate conversion of interleaved float audio through libsamplerate.
+// Feed input in order with process(); finish() flushes the filter tail once the input
+// has ended. When the two rates match, samples pass through unchanged.
+class StreamResampler {
+public:
+  StreamResampler() = default;
+  ~StreamResampler();
+  StreamResampler(const StreamResampler&) = delete;
+  StreamResampler& operator=(const StreamResampler&) = delete;
+
+  bool init(int channels, int inputRate, int outputRate, ResampleQuality quality, std::string& err);
+  // Appends the converted frames for `frames` input frames to `out`.
+  bool process(const float* input, long frames, std::vector<float>& out, std::string& err);
+  bool finish(std::vector<float>& out, std::string& err);
+
+private:
+  bool run(const float* input, long frames, bool endOfInput, std::vector<float>& out, std::string& err);
+
+  SRC_STATE_tag* state_ = nullptr;
+  int channels_ = 0;
+  double ratio_ = 1.0;
+};
@@ -1,14 +1,22 @@
 #include "AuxEngineFacade.h"
 
+#include "SignalKernels.h"
+
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <atomic>
 #include <cctype>
+#include <cerrno>
 #include <filesystem>
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
 #ifdef _WIN32
 #include <io.h>
@@ -16,15 +24,19 @@
 #define AUX_DUP2 _dup2
 #define AUX_FILENO _fileno
 #define AUX_CLOSE _close
+#define AUX_WRITE _write
 #else
+#include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #define AUX_DUP dup
 #define AUX_DUP2 dup2
 #define AUX_FILENO fileno
 #define AUX_CLOSE close
+#define AUX_WRITE write
 #endif
 
-std::optional<SignalData> buildSignalDataFromAuxObj(AuxObj obj, int defaultSampleRate) {
+std::optional<SignalView> buildSignalViewFromAuxObj(AuxObj obj, int defaultSampleRate) {
   if (!obj) {
     return std::nullopt;
   }
@@ -34,17 +46,18 @@ std::optional<SignalData> buildSignalDataFromAuxObj(AuxObj obj, int defaultSampl
     return std::nullopt;
   }
 
-  struct SegmentCopy {
-    int startSample = 0;
-    std::vector<double> samples;
+  struct SegmentHeader {
+    double tmarkMs = 0.0;
+    int length = 0;
+    const double* samples = nullptr;
   };
 
-  SignalData data;
-  data.isAudio = aux_is_audio(obj);
-  data.sampleRate = 0;
+  SignalView view;
+  view.isAudio = aux_is_audio(obj);
+  view.sampleRate = 0;
 
   double minStartMs = std::numeric_limits<double>::infinity();
-  std::vector<std::vector<SegmentCopy>> byChannel(static_cast<size_t>(channels));
+  std::vector<std::vector<SegmentHeader>> byChannel(static_cast<size_t>(channels));
 
   for (int ch = 0; ch < channels; ++ch) {
     const int segCount = aux_num_segments(obj, ch);
@@ -55,71 +68,529 @@ std::optional<SignalData> buildSignalDataFromAuxObj(AuxObj obj, int defaultSampl
       }
       minStartMs = std::min(minStartMs, seg.tmark);
       if (seg.fs > 0) {
-        data.sampleRate = seg.fs;
+        view.sampleRate = seg.fs;
       }
-
-      SegmentCopy copy;
-      copy.samples.resize(seg.nSamples);
-      if (seg.buf && seg.nSamples > 0) {
-        std::copy(seg.buf, seg.buf + seg.nSamples, copy.samples.begin());
-      }
-      byChannel[static_cast<size_t>(ch)].push_back(std::move(copy));
+      byChannel[static_cast<size_t>(ch)].push_back({seg.tmark, static_cast<int>(seg.nSamples), seg.buf});
     }
   }
 
   if (!std::isfinite(minStartMs)) {
     return std::nullopt;
   }
-  if (data.sampleRate <= 0) {
-    data.sampleRate = defaultSampleRate > 0 ? defaultSampleRate : 1;
+  if (view.sampleRate <= 0) {
+    view.sampleRate = defaultSampleRate > 0 ? defaultSampleRate : 1;
   }
 
-  int globalTotalSamples = 0;
+  view.channels.resize(static_cast<size_t>(channels));
   for (int ch = 0; ch < channels; ++ch) {
-    const int segCount = aux_num_segments(obj, ch);
-    for (int segIndex = 0; segIndex < segCount; ++segIndex) {
-      AuxSignal seg{};
-      if (!aux_get_segment(obj, ch, segIndex, seg)) {
-        continue;
+    auto& segments = view.channels[static_cast<size_t>(ch)].segments;
+    for (const auto& header : byChannel[static_cast<size_t>(ch)]) {
+      const int startSample = std::max(0, static_cast<int>(std::llround((header.tmarkMs - minStartMs) * view.sampleRate / 1000.0)));
+      view.totalSamples = std::max(view.totalSamples, startSample + header.length);
+      if (header.length > 0) {
+        segments.push_back({startSample, header.length, header.samples});
       }
-      const int startSample = std::max(0, static_cast<int>(std::llround((seg.tmark - minStartMs) * data.sampleRate / 1000.0)));
-      byChannel[static_cast<size_t>(ch)][static_cast<size_t>(segIndex)].startSample = startSample;
-      globalTotalSamples = std::max(globalTotalSamples, startSample + static_cast<int>(seg.nSamples));
     }
+    std::sort(segments.begin(), segments.end(), [](const SignalSegmentView& lhs, const SignalSegmentView& rhs) {
+      return lhs.startSample < rhs.startSample;
+    });
   }
 
-  if (globalTotalSamples <= 0) {
+  if (view.totalSamples <= 0) {
     return std::nullopt;
   }
 
-  data.channels.reserve(static_cast<size_t>(channels));
-  for (int ch = 0; ch < channels; ++ch) {
+  if (view.isAudio) {
+    view.startTimeSec = minStartMs / 1000.0;
+  }
+  return view;
+}
+
+namespace {
+
+// Gap total (in samples) from which a materialized channel keeps only its segments.
+constexpr long long kSparseMinGapSamples = 1 << 16;
+
+bool shouldStoreSparse(const ChannelView& channel, int totalSamples) {
+  long long covered = 0;
+  int prevEnd = 0;
+  for (const auto& seg : channel.segments) {
+    if (seg.startSample < prevEnd) {
+      // Overlapping segments: the dense copy lets later segments win.
+      return false;
+    }
+    covered += seg.length;
+    prevEnd = seg.startSample + seg.length;
+  }
+  return totalSamples - covered >= kSparseMinGapSamples;
+}
+
+}  // namespace
+
+SignalData materializeSignalView(const SignalView& view) {
+  SignalData data;
+  data.isAudio = view.isAudio;
+  data.sampleRate = view.sampleRate;
+  data.startTimeSec = view.startTimeSec;
+  data.channels.reserve(view.channels.size());
+  for (const auto& channelView : view.channels) {
     ChannelData channel;
-    channel.samples.assign(static_cast<size_t>(globalTotalSamples), 0.0);
-    for (const auto& seg : byChannel[static_cast<size_t>(ch)]) {
-      if (seg.samples.empty()) {
-        continue;
+    if (view.isAudio && shouldStoreSparse(channelView, view.totalSamples)) {
+      channel.sparse = true;
+      channel.length = view.totalSamples;
+      channel.segments.reserve(channelView.segments.size());
+      channel.offsets.reserve(channelView.segments.size());
+      size_t stored = 0;
+      for (const auto& seg : channelView.segments) {
+        stored += static_cast<size_t>(seg.length);
       }
-      const size_t start = static_cast<size_t>(std::max(0, seg.startSample));
-      if (start >= channel.samples.size()) {
-        continue;
+      channel.samples.resize(static_cast<qsizetype>(stored));
+      stored = 0;
+      for (const auto& seg : channelView.segments) {
+        channel.offsets.push_back(stored);
+        if (seg.samples) {
+          std::copy_n(seg.samples, seg.length, channel.samples.begin() + static_cast<qsizetype>(stored));
+        }
+        stored += static_cast<size_t>(seg.length);
+        channel.segments.push_back({seg.startSample, seg.length});
       }
-      const size_t count = std::min(seg.samples.size(), channel.samples.size() - start);
-      std::copy_n(seg.samples.begin(), count, channel.samples.begin() + static_cast<qsizetype>(start));
-      channel.segments.push_back({static_cast<int>(start), static_cast<int>(count)});
+      data.channels.push_back(std::move(channel));
+      continue;
+    }
+    channel.samples.resize(view.totalSamples);
+    channel.segments.reserve(channelView.segments.size());
+    for (const auto& seg : channelView.segments) {
+      if (seg.samples) {
+        std::copy_n(seg.samples, seg.length, channel.samples.begin() + seg.startSample);
+      }
+      channel.segments.push_back({seg.startSample, seg.length});
     }
-    std::sort(channel.segments.begin(), channel.segments.end(), [](const SignalSegment& lhs, const SignalSegment& rhs) {
-      return lhs.startSample < rhs.startSample;
-    });
     data.channels.push_back(std::move(channel));
   }
+  return data;
+}
 
-  if (data.isAudio) {
-    data.startTimeSec = minStartMs / 1000.0;
+SignalInfo signalViewInfo(const SignalView& view) {
+  SignalInfo info;
+  info.isAudio = view.isAudio;
+  info.sampleRate = view.sampleRate;
+  info.startTimeSec = view.startTimeSec;
+  info.totalSamples = view.totalSamples;
+  info.channelSegments.reserve(view.channels.size());
+  for (const auto& channel : view.channels) {
+    std::vector<SignalSegment> segments;
+    segments.reserve(channel.segments.size());
+    for (const auto& seg : channel.segments) {
+      segments.push_back({seg.startSample, seg.length});
+    }
+    info.channelSegments.push_back(std::move(segments));
   }
+  return info;
+}
+
+std::optional<SignalInfo> buildSignalInfoFromAuxObj(AuxObj obj, int defaultSampleRate) {
+  const auto view = buildSignalViewFromAuxObj(obj, defaultSampleRate);
+  if (!view) {
+    return std::nullopt;
+  }
+  return signalViewInfo(*view);
+}
+
+SignalData signalOutline(const SignalInfo& info) {
+  SignalData data;
+  data.isAudio = info.isAudio;
+  data.sampleRate = info.sampleRate;
+  data.startTimeSec = info.startTimeSec;
+  data.channels.resize(info.channelSegments.size());
   return data;
 }
 
+namespace {
+
+// Segments of a view are sorted and disjoint; returns the first one ending after `sample`.
+std::vector<SignalSegmentView>::const_iterator firstSegmentEndingAfter(const ChannelView& channel, int sample) {
+  return std::partition_point(channel.segments.begin(), channel.segments.end(), [sample](const SignalSegmentView& seg) {
+    return seg.startSample + seg.length <= sample;
+  });
+}
+
+}  // namespace
+
+std::vector<double> copySignalViewWindow(const SignalView& view, int channel, int startSample, int length) {
+  if (channel < 0 || channel >= static_cast<int>(view.channels.size()) || length <= 0) {
+    return {};
+  }
+  std::vector<double> out(static_cast<size_t>(length), std::numeric_limits<double>::quiet_NaN());
+  const ChannelView& ch = view.channels[static_cast<size_t>(channel)];
+  const int end = startSample + length;
+  for (auto it = firstSegmentEndingAfter(ch, startSample); it != ch.segments.end() && it->startSample < end; ++it) {
+    if (!it->samples) {
+      continue;
+    }
+    const int from = std::max(startSample, it->startSample);
+    const int to = std::min(end, it->startSample + it->length);
+    std::copy_n(it->samples + (from - it->startSample), to - from, out.begin() + (from - startSample));
+  }
+  return out;
+}
+
+std::vector<double> signalViewEnvelope(const SignalView& view, int channel, int startSample, int length, int blockSize) {
+  if (channel < 0 || channel >= static_cast<int>(view.channels.size()) || length <= 0 || blockSize <= 0) {
+    return {};
+  }
+  const int blocks = (length + blockSize - 1) / blockSize;
+  std::vector<double> lo(static_cast<size_t>(blocks), std::numeric_limits<double>::infinity());
+  std::vector<double> hi(static_cast<size_t>(blocks), -std::numeric_limits<double>::infinity());
+  const ChannelView& ch = view.channels[static_cast<size_t>(channel)];
+  const int end = startSample + length;
+  for (auto it = firstSegmentEndingAfter(ch, startSample); it != ch.segments.end() && it->startSample < end; ++it) {
+    if (!it->samples) {
+      continue;
+    }
+    int from = std::max(startSample, it->startSample);
+    const int to = std::min(end, it->startSample + it->length);
+    while (from < to) {
+      const int block = (from - startSample) / blockSize;
+      const int blockEnd = std::min(to, startSample + (block + 1) * blockSize);
+      accumulateMinMax(it->samples + (from - it->startSample),
+                       static_cast<size_t>(blockEnd - from),
+                       lo[static_cast<size_t>(block)],
+                       hi[static_cast<size_t>(block)]);
+      from = blockEnd;
+    }
+  }
+
+  std::vector<double> out(static_cast<size_t>(blocks) * 2, std::numeric_limits<double>::quiet_NaN());
+  for (int b = 0; b < blocks; ++b) {
+    if (lo[static_cast<size_t>(b)] <= hi[static_cast<size_t>(b)]) {
+      out[static_cast<size_t>(b) * 2] = lo[static_cast<size_t>(b)];
+      out[static_cast<size_t>(b) * 2 + 1] = hi[static_cast<size_t>(b)];
+    }
+  }
+  return out;
+}
+
+std::optional<SignalData> buildSignalDataFromAuxObj(AuxObj obj, int defaultSampleRate) {
+  const auto view = buildSignalViewFromAuxObj(obj, defaultSampleRate);
+  if (!view) {
+    return std::nullopt;
+  }
+  return materializeSignalView(*view);
+}
+
+int channelLength(const ChannelData& channel) {
+  return channel.sparse ? channel.length : static_cast<int>(channel.samples.size());
+}
+
+double channelSample(const ChannelData& channel, int index, double gapValue) {
+  if (index < 0 || index >= channelLength(channel)) {
+    return gapValue;
+  }
+  if (!channel.sparse) {
+    return channel.samples[static_cast<size_t>(index)];
+  }
+  const auto it = std::partition_point(channel.segments.begin(), channel.segments.end(), [index](const SignalSegment& seg) {
+    return seg.startSample + seg.length <= index;
+  });
+  if (it == channel.segments.end() || it->startSample > index) {
+    return gapValue;
+  }
+  const size_t segIndex = static_cast<size_t>(it - channel.segments.begin());
+  return channel.samples[channel.offsets[segIndex] + static_cast<size_t>(index - it->startSample)];
+}
+
+void forEachChannelRun(const ChannelData& channel,
+                       int from,
+                       int to,
+                       const std::function<void(int, const double*, int)>& fn) {
+  from = std::max(0, from);
+  to = std::min(to, channelLength(channel));
+  if (from >= to) {
+    return;
+  }
+  if (!channel.sparse) {
+    fn(from, channel.samples.data() + from, to - from);
+    return;
+  }
+  auto it = std::partition_point(channel.segments.begin(), channel.segments.end(), [from](const SignalSegment& seg) {
+    return seg.startSample + seg.length <= from;
+  });
+  for (; it != channel.segments.end() && it->startSample < to; ++it) {
+    const int runStart = std::max(from, it->startSample);
+    const int runEnd = std::min(to, it->startSample + it->length);
+    const size_t segIndex = static_cast<size_t>(it - channel.segments.begin());
+    fn(runStart, channel.samples.data() + channel.offsets[segIndex] + (runStart - it->startSample), runEnd - runStart);
+  }
+}
+
+std::vector<double> copyChannelWindow(const ChannelData& channel, int startSample, int length, double gapValue) {
+  if (length <= 0) {
+    return {};
+  }
+  std::vector<double> out(static_cast<size_t>(length), gapValue);
+  forEachChannelRun(channel, startSample, startSample + length, [&](int start, const double* samples, int count) {
+    std::copy_n(samples, count, out.begin() + (start - startSample));
+  });
+  return out;
+}
+
+// Persistent pipes for stdout/stderr that a reader thread drains. The process
+// descriptors point at the pipes only while a capture is active, so output
+// outside an eval reaches the terminal directly with its usual buffering and is
+// never held in a pipe. Opening the pipes and starting the reader happens once,
+// so capturing costs two dup2() calls per command instead of temporary files.
+// Descriptors are process-wide, so this only catches what the engine writes through
+// C stdio; std::cout/std::cerr are routed per thread (ThreadRoutedStreamBuf) and Qt
+// messages bypass the descriptors (AuxEngineFacade::writeUncaptured).
+// Not available on Windows, where ScopedStdCapture falls back to temporary files.
+class StdStreamCapture {
+public:
+  struct Mark {
+    size_t outStart = 0;
+    size_t errStart = 0;
+  };
+
+  StdStreamCapture() = default;
+  ~StdStreamCapture() { shutdown(); }
+
+  StdStreamCapture(const StdStreamCapture&) = delete;
+  StdStreamCapture& operator=(const StdStreamCapture&) = delete;
+
+  bool open() {
+#ifdef _WIN32
+    return false;
+#else
+    if (open_) {
+      return true;
+    }
+    // stdio picks a stream's buffering from its descriptor at the first write, which
+    // could happen while the descriptor is a pipe; keep a terminal line buffered.
+    if (::isatty(AUX_FILENO(stdout))) {
+      std::setvbuf(stdout, nullptr, _IOLBF, BUFSIZ);
+    }
+    int wake[2] = {-1, -1};
+    if (::pipe(wake) != 0) {
+      return false;
+    }
+    wakeRead_ = wake[0];
+    wakeWrite_ = wake[1];
+    if (!openStream(out_, AUX_FILENO(stdout)) || !openStream(err_, AUX_FILENO(stderr))) {
+      shutdown();
+      return false;
+    }
+    open_ = true;
+    reader_ = std::thread([this]() { readerLoop(); });
+    return true;
+#endif
+  }
+
+  bool isOpen() const { return open_; }
+
+  // Output written after begin() and before the matching end() belongs to that
+  // capture; a nested capture takes its range out of the enclosing one.
+  Mark begin() {
+    std::fflush(stdout);
+    std::fflush(stderr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (depth_++ == 0) {
+      redirect(true);
+    }
+    // Text an enclosing capture wrote so far must not land in this one's range.
+    std::string unused;
+    drainLocked(out_, unused);
+    drainLocked(err_, unused);
+    return {out_.buffer.size(), err_.buffer.size()};
+  }
+
+  std::string end(const Mark& mark) {
+    std::fflush(stdout);
+    std::fflush(stderr);
+    std::string outSpill;
+    std::string errSpill;
+    std::string text;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (depth_ == 1) {
+        redirect(false);
+      }
+      // Everything flushed above is in the pipes now; take it before leaving the capture.
+      drainLocked(out_, outSpill);
+      drainLocked(err_, errSpill);
+      const size_t outStart = std::min(mark.outStart, out_.buffer.size());
+      const size_t errStart = std::min(mark.errStart, err_.buffer.size());
+      text = out_.buffer.substr(outStart);
+      text.append(err_.buffer, errStart, std::string::npos);
+      out_.buffer.resize(outStart);
+      err_.buffer.resize(errStart);
+      if (depth_ > 0) {
+        --depth_;
+      }
+    }
+    forward(out_.savedFd, outSpill);
+    forward(err_.savedFd, errSpill);
+    return text;
+  }
+
+private:
+  struct Stream {
+    int targetFd = -1;
+    int savedFd = -1;
+    int readFd = -1;
+    int writeFd = -1;
+    std::string buffer;
+  };
+
+#ifndef _WIN32
+  bool openStream(Stream& s, int targetFd) {
+    int fds[2] = {-1, -1};
+    if (::pipe(fds) != 0) {
+      return false;
+    }
+    s.savedFd = AUX_DUP(targetFd);
+    if (s.savedFd < 0) {
+      AUX_CLOSE(fds[0]);
+      AUX_CLOSE(fds[1]);
+      return false;
+    }
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    s.targetFd = targetFd;
+    s.readFd = fds[0];
+    s.writeFd = fds[1];
+    return true;
+  }
+
+  void redirect(bool toPipes) {
+    for (Stream* s : {&out_, &err_}) {
+      AUX_DUP2(toPipes ? s->writeFd : s->savedFd, s->targetFd);
+    }
+  }
+
+  // Drained text goes to the capture buffers; bytes that arrive after the last
+  // capture ended are written to the original descriptors outside the lock.
+  void readerLoop() {
+    pollfd fds[3] = {{out_.readFd, POLLIN, 0}, {err_.readFd, POLLIN, 0}, {wakeRead_, POLLIN, 0}};
+    std::string outSpill;
+    std::string errSpill;
+    while (true) {
+      if (::poll(fds, 3, -1) < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      if (fds[2].revents != 0) {
+        break;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fds[0].revents != 0) {
+          drainLocked(out_, outSpill);
+        }
+        if (fds[1].revents != 0) {
+          drainLocked(err_, errSpill);
+        }
+      }
+      forward(out_.savedFd, outSpill);
+      forward(err_.savedFd, errSpill);
+    }
+  }
+#endif
+
+  void drainLocked(Stream& s, std::string& spill) {
+#ifndef _WIN32
+    if (s.readFd < 0) {
+      return;
+    }
+    char buf[4096];
+    while (true) {
+      const ssize_t n = ::read(s.readFd, buf, sizeof(buf));
+      if (n > 0) {
+        (depth_ > 0 ? s.buffer : spill).append(buf, static_cast<size_t>(n));
+        continue;
+      }
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+#else
+    (void)s;
+    (void)spill;
+#endif
+  }
+
+  static void forward(int fd, std::string& data) {
+    forward(fd, data.data(), data.size());
+    data.clear();
+  }
+
+  static void forward(int fd, const char* data, size_t len) {
+#ifndef _WIN32
+    while (fd >= 0 && len > 0) {
+      const ssize_t n = ::write(fd, data, len);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        return;
+      }
+      data += n;
+      len -= static_cast<size_t>(n);
+    }
+#else
+    (void)fd;
+    (void)data;
+    (void)len;
+#endif
+  }
+
+  void shutdown() {
+#ifndef _WIN32
+    if (reader_.joinable()) {
+      const char wake = 1;
+      forward(wakeWrite_, &wake, 1);
+      reader_.join();
+    }
+    std::fflush(stdout);
+    std::fflush(stderr);
+    if (depth_ > 0) {
+      redirect(false);
+      depth_ = 0;
+    }
+    for (Stream* s : {&out_, &err_}) {
+      std::string spill;
+      drainLocked(*s, spill);
+      forward(s->savedFd, spill);
+      for (int* fd : {&s->savedFd, &s->readFd, &s->writeFd}) {
+        if (*fd >= 0) {
+          AUX_CLOSE(*fd);
+          *fd = -1;
+        }
+      }
+      s->buffer.clear();
+    }
+    if (wakeRead_ >= 0) {
+      AUX_CLOSE(wakeRead_);
+      wakeRead_ = -1;
+    }
+    if (wakeWrite_ >= 0) {
+      AUX_CLOSE(wakeWrite_);
+      wakeWrite_ = -1;
+    }
+#endif
+    open_ = false;
+  }
+
+  Stream out_;
+  Stream err_;
+  int wakeRead_ = -1;
+  int wakeWrite_ = -1;
+  int depth_ = 0;
+  bool open_ = false;
+  std::mutex mutex_;
+  std::thread reader_;
+};
+
 namespace {
 constexpr uint16_t kTypeString = 0x0030;
 constexpr uint16_t kTypeByte = 0x0050;
@@ -236,12 +707,136 @@ bool isIdent(const std::string& s) {
   return true;
 }
 
+std::string pathRootName(const std::string& path) {
+  const size_t end = path.find_first_of(".{(");
+  return end == std::string::npos ? path : path.substr(0, end);
+}
+
+struct PathStep {
+  bool isCell = false;
+  std::string member;
+  size_t index = 0;  // zero-based cell index
+};
+
+// Splits "root", "root.member" or "root{3}" into the root identifier and at most one
+// member or cell step, the only paths resolved natively. Deeper paths, index
+// arithmetic, `end` and parentheses return false and are left to the engine's
+// evaluator.
+bool parseMemberPath(const std::string& path, std::string& root, std::optional<PathStep>& step) {
+  step.reset();
+  const size_t i = std::min(path.find_first_of(".{"), path.size());
+  root = path.substr(0, i);
+  if (!isIdent(root)) {
+    return false;
+  }
+  if (i == path.size()) {
+    return true;
+  }
+  PathStep next;
+  if (path[i] == '.') {
+    next.member = path.substr(i + 1);
+    if (!isIdent(next.member)) {
+      return false;
+    }
+  } else {
+    if (path.back() != '}' || path.size() < i + 3) {
+      return false;
+    }
+    size_t oneBased = 0;
+    for (size_t k = i + 1; k + 1 < path.size(); ++k) {
+      const unsigned char ch = static_cast<unsigned char>(path[k]);
+      if (!std::isdigit(ch) || oneBased > (std::numeric_limits<size_t>::max() - 9) / 10) {
+        return false;
+      }
+      oneBased = oneBased * 10 + static_cast<size_t>(ch - '0');
+    }
+    if (oneBased == 0) {
+      return false;
+    }
+    next.isCell = true;
+    next.index = oneBased - 1;
+  }
+  step = std::move(next);
+  return true;
+}
+
+AuxObj stepInto(auxContext* ctx, const std::string& parentName, const PathStep& step) {
+  if (step.isCell) {
+    const std::vector<AuxObj> cells = aux_get_cell(ctx, parentName);
+    return step.index < cells.size() ? cells[step.index] : nullptr;
+  }
+  const std::map<std::string, AuxObj> members = aux_get_struct(ctx, parentName);
+  const auto it = members.find(step.member);
+  return it != members.end() ? it->second : nullptr;
+}
+
+// Identifiers that appear in a command are the only workspace variables the command
+// can assign to by name; UDF calls and eval() are handled by the caller. Words inside
+// "string" literals and after a // comment are not identifiers.
+std::vector<std::string> commandIdentifiers(const std::string& command) {
+  std::vector<std::string> out;
+  size_t i = 0;
+  while (i < command.size()) {
+    const unsigned char c = static_cast<unsigned char>(command[i]);
+    if (c == '"') {
+      for (++i; i < command.size() && command[i] != '"'; ++i) {
+        if (command[i] == '\\') {
+          ++i;
+        }
+      }
+      ++i;
+      continue;
+    }
+    if (c == '/' && i + 1 < command.size() && command[i + 1] == '/') {
+      i = command.find('\n', i);
+      if (i == std::string::npos) {
+        break;
+      }
+      continue;
+    }
+    if (!(std::isalpha(c) || c == '_')) {
+      ++i;
+      continue;
+    }
+    const size_t begin = i;
+    while (i < command.size() && (std::isalnum(static_cast<unsigned char>(command[i])) || command[i] == '_')) {
+      ++i;
+    }
+    out.push_back(command.substr(begin, i - begin));
+  }
+  return out;
+}
+
+// Commands that can change variables they do not name. eval() is included because the
+// string it runs may be assembled at run time and never spell out the names it assigns.
+bool isWorkspaceWideCommand(const std::string& ident) {
+  return ident == "clear" || ident == "load" || ident == "global" || ident == "eval";
+}
+
+void hashCombine(std::uint64_t& h, std::uint64_t v) {
+  h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+}
+
+std::uint64_t hashDouble(double v) {
+  std::uint64_t bits = 0;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+constexpr const char* kTempPathPrefix = "__auxlab2_tmp_path__";
+
 std::string makeTempPathName() {
   static std::atomic<unsigned long long> counter{0};
   const unsigned long long id = counter.fetch_add(1, std::memory_order_relaxed) + 1;
-  return "__auxlab2_tmp_path__" + std::to_string(id);
+  return kTempPathPrefix + std::to_string(id);
+}
+
+bool isTempPathName(const std::string& name) {
+  return name.compare(0, std::strlen(kTempPathPrefix), kTempPathPrefix) == 0;
 }
 
+}  // namespace
+
 class ScopedPathBinding {
 public:
   ScopedPathBinding() = default;
@@ -279,6 +874,15 @@ public:
     return true;
   }
 
+  // Binds to a workspace variable by name; nothing is deleted on cleanup.
+  bool bindNamed(auxContext* ctx, const std::string& name) {
+    cleanup();
+    ctx_ = ctx;
+    pathName_ = name;
+    obj_ = aux_get_var(ctx_, pathName_);
+    return obj_ != nullptr;
+  }
+
   bool bindDirect(auxContext*& ctx, AuxObj obj) {
     cleanup();
     ctx_ = ctx;
@@ -306,56 +910,7 @@ private:
   std::string tmpName_;
 };
 
-AuxObj resolveObjByPath(auxContext*& ctx, const std::string& path, const auxConfig& cfg, ScopedPathBinding& binding) {
-  const auto dot = path.find('.');
-  const auto brace = path.find('{');
-
-  // Direct one-level struct-member resolution: root.member
-  if (dot != std::string::npos && brace == std::string::npos) {
-    const std::string root = path.substr(0, dot);
-    const std::string member = path.substr(dot + 1);
-    if (isIdent(root) && isIdent(member) && path.find('.', dot + 1) == std::string::npos) {
-      auto members = aux_get_struct(ctx, root);
-      auto it = members.find(member);
-      if (it != members.end() && binding.bindDirect(ctx, it->second)) {
-        return it->second;
-      }
-    }
-  }
-
-  // Direct one-level cell-member resolution: root{N}
-  if (brace != std::string::npos && dot == std::string::npos) {
-    const std::string root = path.substr(0, brace);
-    if (isIdent(root) && path.back() == '}') {
-      const size_t close = path.find('}', brace + 1);
-      if (close == path.size() - 1) {
-        const std::string idxText = path.substr(brace + 1, close - brace - 1);
-        bool digits = !idxText.empty();
-        for (char ch : idxText) {
-          if (!std::isdigit(static_cast<unsigned char>(ch))) {
-            digits = false;
-            break;
-          }
-        }
-        if (digits) {
-          const size_t oneBased = static_cast<size_t>(std::stoul(idxText));
-          if (oneBased > 0) {
-            auto cells = aux_get_cell(ctx, root);
-            const size_t idx = oneBased - 1;
-            if (idx < cells.size() && binding.bindDirect(ctx, cells[idx])) {
-              return cells[idx];
-            }
-          }
-        }
-      }
-    }
-  }
-
-  if (!binding.bind(ctx, path, cfg)) {
-    return nullptr;
-  }
-  return binding.obj();
-}
+namespace {
 
 std::string formatRmsDb(const AuxObj& obj) {
   const int channels = aux_num_channels(obj);
@@ -377,19 +932,21 @@ std::string formatRmsDb(const AuxObj& obj) {
       continue;
     }
 
-    std::vector<double> samples(len, 0.0);
-    aux_flatten_channel(obj, ch, samples.data(), samples.size());
-
-    long double sumSq = 0.0;
-    for (double v : samples) {
-      sumSq += static_cast<long double>(v) * static_cast<long double>(v);
+    // Stream over the engine segments; gaps between them contribute nothing.
+    double sumSq = 0.0;
+    const int segCount = aux_num_segments(obj, ch);
+    for (int segIndex = 0; segIndex < segCount; ++segIndex) {
+      AuxSignal seg{};
+      if (aux_get_segment(obj, ch, segIndex, seg)) {
+        sumSq += sumOfSquares(seg.buf, seg.nSamples);
+      }
     }
-    const long double mean = sumSq / static_cast<long double>(len);
+    const double mean = sumSq / static_cast<double>(len);
     if (mean <= 0.0) {
       out << "-inf";
       continue;
     }
-    const double rmsDb = 20.0 * std::log10(std::sqrt(static_cast<double>(mean))) + kRmsDbOffset;
+    const double rmsDb = 20.0 * std::log10(std::sqrt(mean)) + kRmsDbOffset;
     out << std::fixed << std::setprecision(1) << rmsDb;
   }
   return out.str();
@@ -413,33 +970,92 @@ std::string readTmpFile(FILE* f) {
   return out;
 }
 
-class ScopedStdCapture {
-public:
-  ScopedStdCapture() {
-    std::fflush(stdout);
-    std::fflush(stderr);
+// The calling thread's active capture buffers for std::cout (0) and std::cerr (1).
+thread_local std::ostringstream* tlStreamCaptures[2] = {nullptr, nullptr};
 
-    oldStdoutFd_ = AUX_DUP(AUX_FILENO(stdout));
-    oldStderrFd_ = AUX_DUP(AUX_FILENO(stderr));
-    if (oldStdoutFd_ < 0 || oldStderrFd_ < 0) {
+// Duplicates of the process's stdout (0) and stderr (1), taken before any capture
+// redirects the descriptors.
+int uncapturedFd(int slot) {
+  static const int fds[2] = {AUX_DUP(AUX_FILENO(stdout)), AUX_DUP(AUX_FILENO(stderr))};
+  return fds[slot] >= 0 ? fds[slot] : AUX_FILENO(slot == 0 ? stdout : stderr);
+}
+
+void writeAll(int fd, const char* data, size_t len) {
+  while (len > 0) {
+    const auto n = AUX_WRITE(fd, data, static_cast<unsigned>(std::min<size_t>(len, 1u << 20)));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
       return;
     }
+    data += n;
+    len -= static_cast<size_t>(n);
+  }
+}
 
-    stdoutTmp_ = std::tmpfile();
-    stderrTmp_ = std::tmpfile();
-    if (!stdoutTmp_ || !stderrTmp_) {
-      return;
+// Sends std::cout/std::cerr text written on a thread with an active ScopedStdCapture
+// to that capture, and everything else straight to the uncaptured descriptors, so
+// another thread's stream output never lands in a command's output even while the
+// eval thread has the process descriptors redirected. It is installed once, before the
+// eval thread exists, so no capture swaps a global rdbuf while another thread writes.
+// Unbuffered: each write is routed by the thread that makes it.
+class ThreadRoutedStreamBuf final : public std::streambuf {
+public:
+  explicit ThreadRoutedStreamBuf(int slot) : slot_(slot) {}
+
+protected:
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
     }
+    const char c = traits_type::to_char_type(ch);
+    return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+  }
 
-    if (AUX_DUP2(AUX_FILENO(stdoutTmp_), AUX_FILENO(stdout)) < 0) {
-      return;
+  std::streamsize xsputn(const char* data, std::streamsize count) override {
+    if (std::ostringstream* capture = tlStreamCaptures[slot_]) {
+      capture->write(data, count);
+      return count;
     }
-    if (AUX_DUP2(AUX_FILENO(stderrTmp_), AUX_FILENO(stderr)) < 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Keep ordering with text this thread already wrote through C stdio.
+    std::fflush(slot_ == 0 ? stdout : stderr);
+    writeAll(uncapturedFd(slot_), data, static_cast<size_t>(count));
+    return count;
+  }
+
+private:
+  const int slot_;
+  std::mutex mutex_;
+};
+
+void installThreadStreamRouting() {
+  static std::once_flag once;
+  std::call_once(once, []() {
+    uncapturedFd(0);
+    // Never freed: the standard streams stay usable during static destruction.
+    std::cout.rdbuf(new ThreadRoutedStreamBuf(0));
+    std::cerr.rdbuf(new ThreadRoutedStreamBuf(1));
+  });
+}
+
+class ScopedStdCapture {
+public:
+  explicit ScopedStdCapture(StdStreamCapture* channel)
+      : channel_(channel && channel->isOpen() ? channel : nullptr) {
+    if (channel_) {
+      mark_ = channel_->begin();
+    } else if (!redirectToTmpFiles()) {
       return;
     }
 
-    oldCoutBuf_ = std::cout.rdbuf(coutBuffer_.rdbuf());
-    oldCerrBuf_ = std::cerr.rdbuf(cerrBuffer_.rdbuf());
+    installThreadStreamRouting();
+    prevCoutCapture_ = tlStreamCaptures[0];
+    prevCerrCapture_ = tlStreamCaptures[1];
+    tlStreamCaptures[0] = &coutBuffer_;
+    tlStreamCaptures[1] = &cerrBuffer_;
+    routed_ = true;
     active_ = true;
   }
 
@@ -447,27 +1063,64 @@ public:
     restore();
   }
 
-  std::string output() const {
+  std::string output() {
     std::cout.flush();
     std::cerr.flush();
-    std::string s = readTmpFile(stdoutTmp_);
-    s += readTmpFile(stderrTmp_);
+    std::string s;
+    if (channel_) {
+      finishChannel();
+      s = channelText_;
+    } else {
+      s = readTmpFile(stdoutTmp_);
+      s += readTmpFile(stderrTmp_);
+    }
     s += coutBuffer_.str();
     s += cerrBuffer_.str();
     return s;
   }
 
 private:
-  void restore() {
-    if (oldCoutBuf_) {
-      std::cout.rdbuf(oldCoutBuf_);
-      oldCoutBuf_ = nullptr;
+  bool redirectToTmpFiles() {
+    std::fflush(stdout);
+    std::fflush(stderr);
+
+    oldStdoutFd_ = AUX_DUP(AUX_FILENO(stdout));
+    oldStderrFd_ = AUX_DUP(AUX_FILENO(stderr));
+    if (oldStdoutFd_ < 0 || oldStderrFd_ < 0) {
+      return false;
     }
-    if (oldCerrBuf_) {
-      std::cerr.rdbuf(oldCerrBuf_);
-      oldCerrBuf_ = nullptr;
+
+    stdoutTmp_ = std::tmpfile();
+    stderrTmp_ = std::tmpfile();
+    if (!stdoutTmp_ || !stderrTmp_) {
+      return false;
     }
 
+    if (AUX_DUP2(AUX_FILENO(stdoutTmp_), AUX_FILENO(stdout)) < 0) {
+      return false;
+    }
+    if (AUX_DUP2(AUX_FILENO(stderrTmp_), AUX_FILENO(stderr)) < 0) {
+      return false;
+    }
+    return true;
+  }
+
+  void finishChannel() {
+    if (channel_ && !channelFinished_) {
+      channelText_ = channel_->end(mark_);
+      channelFinished_ = true;
+    }
+  }
+
+  void restore() {
+    if (routed_) {
+      tlStreamCaptures[0] = prevCoutCapture_;
+      tlStreamCaptures[1] = prevCerrCapture_;
+      routed_ = false;
+    }
+
+    finishChannel();
+
     std::fflush(stdout);
     std::fflush(stderr);
 
@@ -493,6 +1146,10 @@ private:
     active_ = false;
   }
 
+  StdStreamCapture* channel_ = nullptr;
+  StdStreamCapture::Mark mark_;
+  bool channelFinished_ = false;
+  std::string channelText_;
   bool active_ = false;
   int oldStdoutFd_ = -1;
   int oldStderrFd_ = -1;
@@ -500,8 +1157,9 @@ private:
   FILE* stderrTmp_ = nullptr;
   std::ostringstream coutBuffer_;
   std::ostringstream cerrBuffer_;
-  std::streambuf* oldCoutBuf_ = nullptr;
-  std::streambuf* oldCerrBuf_ = nullptr;
+  std::ostringstream* prevCoutCapture_ = nullptr;
+  std::ostringstream* prevCerrCapture_ = nullptr;
+  bool routed_ = false;
 };
 }  // namespace
 
@@ -522,11 +1180,23 @@ AuxEngineFacade::~AuxEngineFacade() {
 }
 
 bool AuxEngineFacade::init() {
+  // Before the first capture and before any eval thread starts.
+  installThreadStreamRouting();
+  if (!stdCapture_) {
+    stdCapture_ = std::make_unique<StdStreamCapture>();
+    if (!stdCapture_->open()) {
+      stdCapture_.reset();
+    }
+  }
   rootCtx_ = aux_init(&cfg_);
   activeCtx_ = rootCtx_;
   return rootCtx_ != nullptr;
 }
 
+void AuxEngineFacade::writeUncaptured(const std::string& text) {
+  writeAll(uncapturedFd(1), text.data(), text.size());
+}
+
 bool AuxEngineFacade::installGraphicsBackend(const auxGraphicsBackend& backend, std::string& err) {
   if (!rootCtx_) {
     err = "AUX engine is not initialized.";
@@ -576,10 +1246,11 @@ EvalResult AuxEngineFacade::eval(const std::string& command) {
   std::string preview;
   std::string captured;
   {
-    ScopedStdCapture cap;
+    ScopedStdCapture cap(stdCapture_.get());
     out.status = aux_eval(&activeCtx_, command, cfg_, preview);
     captured = filterCapturedNoise(cap.output());
   }
+  touchVariables(command);
 
   out.output = captured;
   if (!preview.empty()) {
@@ -617,6 +1288,9 @@ int AuxEngineFacade::pollAsync() {
   if (rootCtx_ && rootCtx_ != activeCtx_) {
     changed += aux_poll_async(rootCtx_);
   }
+  if (changed > 0) {
+    touchAllVariables();
+  }
   return changed;
 }
 
@@ -632,11 +1306,16 @@ std::vector<VarSnapshot> AuxEngineFacade::listVariables() const {
 
   auto names = aux_enum_vars(ctx);
   vars.reserve(names.size());
+  std::unordered_set<std::string> listed;
   for (const auto& name : names) {
+    if (isTempPathName(name)) {
+      continue;
+    }
     auto obj = aux_get_var(ctx, name);
     if (!obj) {
       continue;
     }
+    listed.insert(name);
 
     VarSnapshot snap;
     snap.name = name;
@@ -651,13 +1330,106 @@ std::vector<VarSnapshot> AuxEngineFacade::listVariables() const {
       snap.preview = structFaceOnlyPreview(snap.preview);
     }
     if (snap.isAudio) {
-      snap.rms = formatRmsDb(obj);
+      snap.rms = cachedRmsDb(name, objectVersion(ctx, name, obj), obj);
     }
     vars.push_back(std::move(snap));
   }
+
+  for (auto it = rmsCache_.begin(); it != rmsCache_.end();) {
+    if (listed.count(pathRootName(it->first)) == 0) {
+      it = rmsCache_.erase(it);
+    } else {
+      ++it;
+    }
+  }
   return vars;
 }
 
+std::uint64_t AuxEngineFacade::variableVersion(const std::string& path) const {
+  auxContext* ctx = activeCtx_;
+  if (!ctx || path.empty()) {
+    return 0;
+  }
+  const std::string root = pathRootName(path);
+  return objectVersion(ctx, root, aux_get_var(ctx, root));
+}
+
+AuxObj AuxEngineFacade::resolvePath(auxContext*& ctx, const std::string& path, ScopedPathBinding& binding) const {
+  std::string root;
+  std::optional<PathStep> step;
+  if (!parseMemberPath(path, root, step)) {
+    return binding.bind(ctx, path, cfg_) ? binding.obj() : nullptr;
+  }
+  if (!step) {
+    return binding.bindNamed(ctx, root) ? binding.obj() : nullptr;
+  }
+
+  // The engine only exposes struct/cell members by variable name, so a direct member
+  // of a workspace variable is taken natively; a missing one goes to the evaluator for
+  // its error message.
+  AuxObj obj = stepInto(ctx, root, *step);
+  if (obj && binding.bindDirect(ctx, obj)) {
+    return obj;
+  }
+  return binding.bind(ctx, path, cfg_) ? binding.obj() : nullptr;
+}
+
+bool AuxEngineFacade::bindPath(auxContext*& ctx, const std::string& path, ScopedPathBinding& binding) const {
+  std::string root;
+  std::optional<PathStep> step;
+  if (parseMemberPath(path, root, step) && !step) {
+    return binding.bindNamed(ctx, root);
+  }
+  return binding.bind(ctx, path, cfg_);
+}
+
+std::uint64_t AuxEngineFacade::objectVersion(auxContext* ctx, const std::string& rootName, AuxObj rootObj) const {
+  if (!rootObj) {
+    return 0;
+  }
+
+  std::uint64_t serial = allTouchedSerial_;
+  const auto touched = touchedSerials_.find(rootName);
+  if (touched != touchedSerials_.end()) {
+    serial = std::max(serial, touched->second);
+  }
+
+  // Mutation serial plus a fingerprint of the object headers: a reassignment through
+  // a path the serials cannot see still changes the buffers or layout.
+  std::uint64_t h = serial;
+  hashCombine(h, reinterpret_cast<std::uintptr_t>(ctx));
+  hashCombine(h, aux_type(rootObj));
+  const int channels = aux_num_channels(rootObj);
+  hashCombine(h, static_cast<std::uint64_t>(channels));
+  for (int ch = 0; ch < channels; ++ch) {
+    const int segCount = aux_num_segments(rootObj, ch);
+    hashCombine(h, static_cast<std::uint64_t>(segCount));
+    for (int segIndex = 0; segIndex < segCount; ++segIndex) {
+      AuxSignal seg{};
+      if (!aux_get_segment(rootObj, ch, segIndex, seg)) {
+        continue;
+      }
+      hashCombine(h, reinterpret_cast<std::uintptr_t>(seg.buf));
+      hashCombine(h, static_cast<std::uint64_t>(seg.nSamples));
+      hashCombine(h, hashDouble(seg.tmark));
+      hashCombine(h, static_cast<std::uint64_t>(seg.fs));
+    }
+  }
+  return h == 0 ? 1 : h;
+}
+
+std::string AuxEngineFacade::cachedRmsDb(const std::string& key, std::uint64_t version, AuxObj obj) const {
+  if (version == 0) {
+    return formatRmsDb(obj);
+  }
+  auto& entry = rmsCache_[key];
+  if (entry.version != version) {
+    entry.version = version;
+    entry.text = formatRmsDb(obj);
+  }
+  return entry.text;
+}
+
 std::vector<VarSnapshot> AuxEngineFacade::listStructMembers(const std::string& path) const {
   std::vector<VarSnapshot> out;
   auxContext* ctx = paused_ ? activeCtx_ : rootCtx_;
@@ -669,12 +1441,14 @@ std::vector<VarSnapshot> AuxEngineFacade::listStructMembers(const std::string& p
   }
 
   ScopedPathBinding binding;
-  if (!binding.bind(ctx, path, cfg_)) {
+  if (!bindPath(ctx, path, binding)) {
     return out;
   }
 
   std::map<std::string, AuxObj> members = aux_get_struct(ctx, binding.pathName());
   out.reserve(members.size());
+  const std::string root = pathRootName(path);
+  const std::uint64_t version = objectVersion(ctx, root, aux_get_var(ctx, root));
   for (const auto& kv : members) {
     if (!kv.second) {
       continue;
@@ -692,7 +1466,7 @@ std::vector<VarSnapshot> AuxEngineFacade::listStructMembers(const std::string& p
       snap.preview = structFaceOnlyPreview(snap.preview);
     }
     if (snap.isAudio) {
-      snap.rms = formatRmsDb(kv.second);
+      snap.rms = cachedRmsDb(path + "." + kv.first, version, kv.second);
     }
     out.push_back(std::move(snap));
   }
@@ -710,12 +1484,14 @@ std::vector<VarSnapshot> AuxEngineFacade::listCellMembers(const std::string& pat
   }
 
   ScopedPathBinding binding;
-  if (!binding.bind(ctx, path, cfg_)) {
+  if (!bindPath(ctx, path, binding)) {
     return out;
   }
 
   std::vector<AuxObj> cells = aux_get_cell(ctx, binding.pathName());
   out.reserve(cells.size());
+  const std::string root = pathRootName(path);
+  const std::uint64_t version = objectVersion(ctx, root, aux_get_var(ctx, root));
   for (size_t i = 0; i < cells.size(); ++i) {
     const AuxObj& obj = cells[i];
     if (!obj) {
@@ -734,7 +1510,7 @@ std::vector<VarSnapshot> AuxEngineFacade::listCellMembers(const std::string& pat
       snap.preview = structFaceOnlyPreview(snap.preview);
     }
     if (snap.isAudio) {
-      snap.rms = formatRmsDb(obj);
+      snap.rms = cachedRmsDb(path + "{" + snap.name + "}", version, obj);
     }
     out.push_back(std::move(snap));
   }
@@ -748,13 +1524,69 @@ std::optional<SignalData> AuxEngineFacade::getSignalData(const std::string& varN
   }
 
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return std::nullopt;
   }
   return buildSignalDataFromAuxObj(obj, aux_get_fs(ctx));
 }
 
+std::optional<SignalInfo> AuxEngineFacade::getSignalInfo(const std::string& varName) const {
+  auxContext* ctx = activeCtx_;
+  if (!ctx) {
+    return std::nullopt;
+  }
+
+  ScopedPathBinding binding;
+  auto obj = resolvePath(ctx, varName, binding);
+  if (!obj) {
+    return std::nullopt;
+  }
+  return buildSignalInfoFromAuxObj(obj, aux_get_fs(ctx));
+}
+
+std::optional<std::vector<double>> AuxEngineFacade::getSignalWindow(const std::string& varName,
+                                                                    int channel,
+                                                                    int startSample,
+                                                                    int length) const {
+  std::optional<std::vector<double>> out;
+  withSignalView(varName, [&](const SignalView& view) {
+    out = copySignalViewWindow(view, channel, startSample, length);
+  });
+  return out;
+}
+
+std::optional<std::vector<double>> AuxEngineFacade::getSignalEnvelope(const std::string& varName,
+                                                                      int channel,
+                                                                      int startSample,
+                                                                      int length,
+                                                                      int blockSize) const {
+  std::optional<std::vector<double>> out;
+  withSignalView(varName, [&](const SignalView& view) {
+    out = signalViewEnvelope(view, channel, startSample, length, blockSize);
+  });
+  return out;
+}
+
+bool AuxEngineFacade::withSignalView(const std::string& varName, const std::function<void(const SignalView&)>& fn) const {
+  auxContext* ctx = activeCtx_;
+  if (!ctx || !fn) {
+    return false;
+  }
+
+  ScopedPathBinding binding;
+  auto obj = resolvePath(ctx, varName, binding);
+  if (!obj) {
+    return false;
+  }
+  const auto view = buildSignalViewFromAuxObj(obj, aux_get_fs(ctx));
+  if (!view) {
+    return false;
+  }
+  fn(*view);
+  return true;
+}
+
 std::optional<QVector<double>> AuxEngineFacade::getNumericVector(const std::string& varName) const {
   auxContext* ctx = activeCtx_;
   if (!ctx) {
@@ -762,7 +1594,7 @@ std::optional<QVector<double>> AuxEngineFacade::getNumericVector(const std::stri
   }
 
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return std::nullopt;
   }
@@ -790,7 +1622,7 @@ std::optional<double> AuxEngineFacade::getScalarValue(const std::string& varName
   }
 
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return std::nullopt;
   }
@@ -818,7 +1650,7 @@ std::vector<std::vector<double>> AuxEngineFacade::getSignalFftPowerDb(const std:
 
   auxContext* ctx = activeCtx_;
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return out;
   }
@@ -831,7 +1663,7 @@ std::vector<std::vector<double>> AuxEngineFacade::getSignalFftPowerDb(const std:
   int sampleRate = aux_get_fs(ctx);
   if (sampleRate <= 0) sampleRate = 1;
   int offsetSamples = 0;
-  const auto sig = getSignalData(varName);
+  const auto sig = buildSignalInfoFromAuxObj(obj, sampleRate);
   if (sig && sig->isAudio && sig->sampleRate > 0) {
     sampleRate = sig->sampleRate;
     offsetSamples = std::max(0, static_cast<int>(std::llround(sig->startTimeSec * sampleRate)));
@@ -849,6 +1681,35 @@ std::vector<std::vector<double>> AuxEngineFacade::getSignalFftPowerDb(const std:
   return out;
 }
 
+std::vector<std::vector<double>> AuxEngineFacade::getSignalWelchPowerDb(const std::string& varName,
+                                                                        int viewStart,
+                                                                        int viewLen,
+                                                                        const WelchOptions& options) const {
+  std::vector<std::vector<double>> out;
+  withSignalView(varName, [&](const SignalView& view) {
+    const int offsetSamples = (view.isAudio && view.sampleRate > 0)
+                                  ? std::max(0, static_cast<int>(std::llround(view.startTimeSec * view.sampleRate)))
+                                  : 0;
+    const int start = std::clamp(viewStart - offsetSamples, 0, std::max(0, view.totalSamples));
+    const int len = std::min(std::max(1, viewLen), view.totalSamples - start);
+    const WelchPlan plan = planWelchSegments(start, len, options);
+    if (plan.starts.empty()) {
+      return;
+    }
+
+    out.resize(view.channels.size());
+    for (int ch = 0; ch < static_cast<int>(view.channels.size()); ++ch) {
+      WelchSpectrum spectrum = makeWelchSpectrum(static_cast<size_t>(plan.segmentSize), options.window);
+      for (int segStart : plan.starts) {
+        const std::vector<double> samples = copySignalViewWindow(view, ch, segStart, plan.segmentSize);
+        addWelchSegment(spectrum, samples.data());
+      }
+      out[static_cast<size_t>(ch)] = welchPowerDb(spectrum);
+    }
+  });
+  return out;
+}
+
 std::optional<uint16_t> AuxEngineFacade::getValueType(const std::string& varName) const {
   auxContext* ctx = activeCtx_;
   if (!ctx) {
@@ -856,7 +1717,7 @@ std::optional<uint16_t> AuxEngineFacade::getValueType(const std::string& varName
   }
 
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return std::nullopt;
   }
@@ -869,7 +1730,7 @@ bool AuxEngineFacade::isStringVar(const std::string& varName) const {
     return false;
   }
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return false;
   }
@@ -882,7 +1743,7 @@ bool AuxEngineFacade::isStructVar(const std::string& varName) const {
     return false;
   }
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return false;
   }
@@ -896,7 +1757,7 @@ bool AuxEngineFacade::isCellVar(const std::string& varName) const {
     return false;
   }
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return false;
   }
@@ -909,7 +1770,7 @@ bool AuxEngineFacade::isBinaryVar(const std::string& varName) const {
     return false;
   }
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return false;
   }
@@ -922,7 +1783,7 @@ std::optional<std::string> AuxEngineFacade::getStringValue(const std::string& va
     return std::nullopt;
   }
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return std::nullopt;
   }
@@ -948,7 +1809,7 @@ std::optional<BinaryData> AuxEngineFacade::getBinaryData(const std::string& varN
     return std::nullopt;
   }
   ScopedPathBinding binding;
-  auto obj = resolveObjByPath(ctx, varName, cfg_, binding);
+  auto obj = resolvePath(ctx, varName, binding);
   if (!obj) {
     return std::nullopt;
   }
@@ -1008,6 +1869,7 @@ bool AuxEngineFacade::loadUdfFile(const std::string& fullPath, std::string& err)
     err = "Failed to register UDF.";
     return false;
   }
+  loadedUdfNames_.insert(udfName);
   return true;
 }
 
@@ -1095,6 +1957,7 @@ bool AuxEngineFacade::deleteVar(const std::string& varName) {
   if (!activeCtx_) {
     return false;
   }
+  touchVariable(pathRootName(varName));
   return aux_del_var(activeCtx_, varName) == 0;
 }
 
@@ -1102,6 +1965,7 @@ bool AuxEngineFacade::setHandleValues(const std::string& varName, const std::vec
   if (!activeCtx_ || varName.empty()) {
     return false;
   }
+  touchVariable(pathRootName(varName));
   return aux_set_handle_values(activeCtx_, varName, ids) == 0;
 }
 
@@ -1109,6 +1973,7 @@ bool AuxEngineFacade::updateRuntimeHandleMembers(std::uint64_t handleId, const s
   if (!activeCtx_ || handleId == 0 || members.empty()) {
     return false;
   }
+  touchAllVariables();
   bool updated = false;
   if (aux_update_runtime_handle_members(activeCtx_, handleId, members) == 0) {
     updated = true;
@@ -1133,10 +1998,11 @@ bool AuxEngineFacade::invokeRecordCallback(std::uint64_t sessionId,
   std::string captured;
   int status = 1;
   {
-    ScopedStdCapture cap;
+    ScopedStdCapture cap(stdCapture_.get());
     status = aux_invoke_record_callback(&ctx, sessionId, callbackName, payload, cfg_, preview);
     captured = filterCapturedNoise(cap.output());
   }
+  touchAllVariables();
 
   output = captured;
   if (!preview.empty()) {
@@ -1153,6 +2019,7 @@ bool AuxEngineFacade::invokeRecordCallback(std::uint64_t sessionId,
 
 bool AuxEngineFacade::attachRecordCallbackOutputsToHandle(std::uint64_t sessionId,
                                                           std::uint64_t handleId) {
+  touchAllVariables();
   bool updated = false;
   if (activeCtx_ && aux_attach_record_callback_outputs_to_handle(activeCtx_, sessionId, handleId) == 0) {
     updated = true;
@@ -1237,6 +2104,8 @@ bool AuxEngineFacade::applyRuntimeSettings(const RuntimeSettingsSnapshot& settin
   cfg_.display_limit_bytes = settings.displayLimitBytes;
   cfg_.display_limit_str = settings.displayLimitStr;
   cfg_.search_paths = settings.udfPaths;
+  udfListingValid_ = false;
+  touchAllVariables();
 
   auxContext* ctx = activeCtx_ ? activeCtx_ : rootCtx_;
   if (!ctx && !rootCtx_) {
@@ -1281,6 +2150,7 @@ auxDebugAction AuxEngineFacade::debugResume(auxDebugAction action) {
   }
 
   const auto r = aux_debug_resume(&activeCtx_, action);
+  touchAllVariables();
 
   auxDebugInfo info{};
   if (aux_debug_get_pause_info(activeCtx_, info) == 0) {
@@ -1293,3 +2163,72 @@ auxDebugAction AuxEngineFacade::debugResume(auxDebugAction action) {
   }
   return r;
 }
+
+void AuxEngineFacade::touchVariables(const std::string& command) {
+  const std::uint64_t serial = ++mutationSerial_;
+  std::set<std::string> seen;
+  bool udfNamesListed = false;
+  const auto isUdf = [&](const std::string& ident) {
+    if (!udfNamesListed) {
+      refreshUdfFileNames();
+      udfNamesListed = true;
+    }
+    return isUdfName(ident);
+  };
+  for (const std::string& ident : commandIdentifiers(command)) {
+    if (!seen.insert(ident).second) {
+      continue;
+    }
+    // A UDF can reach the caller's workspace through global declarations or its own
+    // eval() calls, so any command that calls one may have changed anything.
+    if (isWorkspaceWideCommand(ident) || (!aux_get_var(activeCtx_, ident) && isUdf(ident))) {
+      touchAllVariables();
+      return;
+    }
+    touchedSerials_[ident] = serial;
+  }
+}
+
+bool AuxEngineFacade::isUdfName(const std::string& name) const {
+  return loadedUdfNames_.count(name) > 0 || udfFileNames_.count(name) > 0;
+}
+
+void AuxEngineFacade::refreshUdfFileNames() {
+  std::vector<std::string> roots;
+  roots.reserve(cfg_.search_paths.size() + 1);
+  for (const std::string& root : cfg_.search_paths) {
+    if (!root.empty()) {
+      roots.push_back(root);
+    }
+  }
+  std::error_code ec;
+  const std::filesystem::path cwd = std::filesystem::current_path(ec);
+  if (!ec) {
+    roots.push_back(cwd.string());
+  }
+  if (udfListingValid_ && roots == udfListingRoots_) {
+    return;
+  }
+
+  udfFileNames_.clear();
+  for (const std::string& root : roots) {
+    for (std::filesystem::directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+      const std::filesystem::path& file = it->path();
+      if (file.extension() == ".aux") {
+        udfFileNames_.insert(file.stem().string());
+      }
+    }
+    ec.clear();
+  }
+  udfListingRoots_ = std::move(roots);
+  udfListingValid_ = true;
+}
+
+void AuxEngineFacade::touchVariable(const std::string& name) {
+  touchedSerials_[name] = ++mutationSerial_;
+}
+
+void AuxEngineFacade::touchAllVariables() {
+  allTouchedSerial_ = ++mutationSerial_;
+  touchedSerials_.clear();
+}
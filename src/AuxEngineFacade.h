@@ -1,10 +1,15 @@
 #pragma once
 
+#include "SignalKernels.h"
+
 #include <auxe/auxe.h>
 #include <QVector>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 struct VarSnapshot {
@@ -28,9 +33,18 @@ struct SignalSegment {
   int length = 0;
 };
 
+// A dense channel holds its whole timeline in `samples`, with gaps between segments
+// zero-filled. A sparse channel stores only the segments' samples back to back (segment
+// i starts at samples[offsets[i]]) and spans `length` samples; its gaps are implicit.
+// Read either layout through the channel* helpers below. `samples` is implicitly
+// shared: copies of a SignalData, and the ydata of lines drawing it, reference one
+// buffer until something writes to it.
 struct ChannelData {
-  std::vector<double> samples;
+  QVector<double> samples;
   std::vector<SignalSegment> segments;
+  bool sparse = false;
+  int length = 0;
+  std::vector<size_t> offsets;
 };
 
 struct SignalData {
@@ -40,6 +54,38 @@ struct SignalData {
   std::vector<ChannelData> channels;
 };
 
+struct SignalSegmentView {
+  int startSample = 0;
+  int length = 0;
+  const double* samples = nullptr;
+};
+
+struct ChannelView {
+  std::vector<SignalSegmentView> segments;
+};
+
+// Read-only view of an engine signal: segments point straight into the engine's
+// AuxSignal buffers, so a view is only valid while the source object is alive and
+// unmodified. Use materializeSignalView() to obtain an owning SignalData.
+struct SignalView {
+  bool isAudio = false;
+  int sampleRate = 0;
+  double startTimeSec = 0.0;
+  int totalSamples = 0;
+  std::vector<ChannelView> channels;
+};
+
+// Shape and timing of an engine signal, read from the AuxSignal headers only.
+struct SignalInfo {
+  bool isAudio = false;
+  int sampleRate = 0;
+  double startTimeSec = 0.0;
+  int totalSamples = 0;
+  std::vector<std::vector<SignalSegment>> channelSegments;
+
+  int channelCount() const { return static_cast<int>(channelSegments.size()); }
+};
+
 struct BinaryData {
   std::vector<unsigned char> bytes;
 };
@@ -54,14 +100,43 @@ struct RuntimeSettingsSnapshot {
   std::vector<std::string> udfPaths;
 };
 
+std::optional<SignalView> buildSignalViewFromAuxObj(AuxObj obj, int defaultSampleRate);
+SignalData materializeSignalView(const SignalView& view);
+std::optional<SignalInfo> buildSignalInfoFromAuxObj(AuxObj obj, int defaultSampleRate);
+SignalInfo signalViewInfo(const SignalView& view);
+// SignalData carrying only the rate, timing and channel count of `info` (no samples).
+SignalData signalOutline(const SignalInfo& info);
+// Samples [startSample, startSample + length) of one channel; gaps read as NaN.
+std::vector<double> copySignalViewWindow(const SignalView& view, int channel, int startSample, int length);
+// Interleaved (min, max) pairs for consecutive blocks of `blockSize` samples over the
+// same range; blocks that fall entirely in a gap hold NaN.
+std::vector<double> signalViewEnvelope(const SignalView& view, int channel, int startSample, int length, int blockSize);
 std::optional<SignalData> buildSignalDataFromAuxObj(AuxObj obj, int defaultSampleRate);
 
+int channelLength(const ChannelData& channel);
+// Sample `index` of the channel timeline; `gapValue` in gaps and out of range.
+double channelSample(const ChannelData& channel, int index, double gapValue = 0.0);
+// Calls fn(startSample, samples, count) for each stored run of samples overlapping
+// [from, to), in timeline order. Gaps of a sparse channel produce no call.
+void forEachChannelRun(const ChannelData& channel,
+                       int from,
+                       int to,
+                       const std::function<void(int, const double*, int)>& fn);
+// Samples [startSample, startSample + length) of the channel; gaps read as `gapValue`.
+std::vector<double> copyChannelWindow(const ChannelData& channel, int startSample, int length, double gapValue = 0.0);
+
+class StdStreamCapture;
+class ScopedPathBinding;
+
 class AuxEngineFacade {
 public:
   AuxEngineFacade();
   ~AuxEngineFacade();
 
   bool init();
+  // Writes to the process's stderr even while a command's capture has redirected it,
+  // so diagnostics that are not the engine's (e.g. Qt warnings) stay out of its output.
+  static void writeUncaptured(const std::string& text);
   bool installGraphicsBackend(const auxGraphicsBackend& backend, std::string& err);
   bool installPlaybackBackend(const auxPlaybackBackend& backend, std::string& err);
   void clearGraphicsBackend();
@@ -70,12 +145,29 @@ public:
   int pollAsync();
 
   std::vector<VarSnapshot> listVariables() const;
+  // Returns a value that changes whenever the variable at `path` (or its root
+  // variable, for member paths) may have changed; 0 if the path does not resolve.
+  std::uint64_t variableVersion(const std::string& path) const;
   std::vector<VarSnapshot> listStructMembers(const std::string& path) const;
   std::vector<VarSnapshot> listCellMembers(const std::string& path) const;
   std::optional<SignalData> getSignalData(const std::string& varName) const;
+  std::optional<SignalInfo> getSignalInfo(const std::string& varName) const;
+  std::optional<std::vector<double>> getSignalWindow(const std::string& varName, int channel, int startSample, int length) const;
+  std::optional<std::vector<double>> getSignalEnvelope(const std::string& varName,
+                                                       int channel,
+                                                       int startSample,
+                                                       int length,
+                                                       int blockSize) const;
+  bool withSignalView(const std::string& varName, const std::function<void(const SignalView&)>& fn) const;
   std::optional<QVector<double>> getNumericVector(const std::string& varName) const;
   std::optional<double> getScalarValue(const std::string& varName) const;
   std::vector<std::vector<double>> getSignalFftPowerDb(const std::string& varName, int viewStart, int viewLen) const;
+  // Welch spectrum of the same range per channel; the work is bounded by the options,
+  // not by viewLen.
+  std::vector<std::vector<double>> getSignalWelchPowerDb(const std::string& varName,
+                                                         int viewStart,
+                                                         int viewLen,
+                                                         const WelchOptions& options) const;
   std::optional<BinaryData> getBinaryData(const std::string& varName) const;
   std::optional<uint16_t> getValueType(const std::string& varName) const;
   bool isBinaryVar(const std::string& varName) const;
@@ -106,9 +198,35 @@ public:
   auxDebugAction debugResume(auxDebugAction action);
 
 private:
+  struct RmsCacheEntry {
+    std::uint64_t version = 0;
+    std::string text;
+  };
+
+  std::uint64_t objectVersion(auxContext* ctx, const std::string& rootName, AuxObj rootObj) const;
+  std::string cachedRmsDb(const std::string& key, std::uint64_t version, AuxObj obj) const;
+  AuxObj resolvePath(auxContext*& ctx, const std::string& path, ScopedPathBinding& binding) const;
+  bool bindPath(auxContext*& ctx, const std::string& path, ScopedPathBinding& binding) const;
+  void touchVariables(const std::string& command);
+  bool isUdfName(const std::string& name) const;
+  void refreshUdfFileNames();
+  void touchVariable(const std::string& name);
+  void touchAllVariables();
+
   auxConfig cfg_{};
   auxContext* rootCtx_ = nullptr;
   mutable auxContext* activeCtx_ = nullptr;
   bool paused_ = false;
   auxDebugInfo pauseInfo_{};
+  std::uint64_t mutationSerial_ = 0;
+  std::uint64_t allTouchedSerial_ = 0;
+  std::unordered_map<std::string, std::uint64_t> touchedSerials_;
+  std::set<std::string> loadedUdfNames_;
+  // Stems of the .aux files in udfListingRoots_ (the UDF search paths, then the working
+  // directory), listed once and reused until the roots change.
+  std::vector<std::string> udfListingRoots_;
+  std::set<std::string> udfFileNames_;
+  bool udfListingValid_ = false;
+  mutable std::unordered_map<std::string, RmsCacheEntry> rmsCache_;
+  std::unique_ptr<StdStreamCapture> stdCapture_;
 };
@@ -139,10 +139,25 @@ void CommandConsole::appendAsyncOutput(const QString& output) {
   ensureEditableCursor();
 }
 
+void CommandConsole::setBusy(bool busy) {
+  busy_ = busy;
+}
+
 void CommandConsole::keyPressEvent(QKeyEvent* event) {
   const int key = event->key();
   const auto mods = event->modifiers();
 
+#ifdef Q_OS_MAC
+  const bool interruptChord = key == Qt::Key_C && (mods & Qt::MetaModifier);
+#else
+  const bool interruptChord = key == Qt::Key_C && (mods & Qt::ControlModifier);
+#endif
+  if (busy_ && interruptChord && !textCursor().hasSelection()) {
+    emit interruptRequested();
+    event->accept();
+    return;
+  }
+
   if (event->matches(QKeySequence::Copy)) {
     QTextCursor c = textCursor();
     if (!c.hasSelection()) {
@@ -14,11 +14,13 @@ public:
   void submitCurrentCommand();
   void appendExecutionResult(const QString& output);
   void appendAsyncOutput(const QString& output);
+  void setBusy(bool busy);
 
 signals:
   void commandSubmitted(const QString& cmd);
   void historyNavigateRequested(int delta);
   void reverseSearchRequested();
+  void interruptRequested();
 
 protected:
   bool event(QEvent* event) override;
@@ -33,4 +35,5 @@ private:
   QString prompt_ = "AUX> ";
   QColor promptColor_ = QColor(90, 180, 255);
   int inputStartPos_ = 0;
+  bool busy_ = false;
 };
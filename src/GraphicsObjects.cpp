@@ -13,6 +13,18 @@ QColor kDefaultFigureColor(212, 212, 196);
 QColor kDefaultAxesColor(188, 196, 190);
 QColor kDefaultLeftLineColor(28, 62, 178);
 QColor kDefaultRightLineColor(255, 86, 86);
+
+// True when the segments leave part of [0, length) uncovered.
+bool hasGaps(const std::vector<SignalSegment>& segments, size_t length) {
+  size_t covered = 0;
+  for (const auto& seg : segments) {
+    if (static_cast<size_t>(std::max(0, seg.startSample)) > covered) {
+      return true;
+    }
+    covered = std::max(covered, static_cast<size_t>(std::max(0, seg.startSample + seg.length)));
+  }
+  return covered < length;
+}
 }  // namespace
 
 GraphicsFigureModel GraphicsFigureModel::createEmptyFigure(const QString& title,
@@ -299,31 +311,36 @@ void GraphicsFigureModel::syncLineData(const SignalData& data) {
       continue;
     }
 
+    if (data.channels[static_cast<size_t>(line.logicalChannel)].sparse) {
+      // Sparse channels are drawn straight from the SignalData; a ydata copy would
+      // allocate the gaps again.
+      continue;
+    }
     const auto& channel = data.channels[static_cast<size_t>(line.logicalChannel)].samples;
     const auto& segments = data.channels[static_cast<size_t>(line.logicalChannel)].segments;
-    line.ydata.reserve(static_cast<qsizetype>(channel.size()));
-    if (data.isAudio && !segments.empty()) {
+    const size_t channelSize = static_cast<size_t>(channel.size());
+    if (data.isAudio && !segments.empty() && hasGaps(segments, channelSize)) {
+      // Gaps read as NaN so they are not drawn, which needs a copy of its own.
       const double gapValue = std::numeric_limits<double>::quiet_NaN();
-      line.ydata.fill(gapValue, static_cast<qsizetype>(channel.size()));
+      line.ydata.fill(gapValue, channel.size());
       for (const auto& seg : segments) {
         const size_t start = static_cast<size_t>(std::max(0, seg.startSample));
-        if (start >= channel.size() || seg.length <= 0) {
+        if (start >= channelSize || seg.length <= 0) {
           continue;
         }
-        const size_t count = std::min(static_cast<size_t>(seg.length), channel.size() - start);
+        const size_t count = std::min(static_cast<size_t>(seg.length), channelSize - start);
         for (size_t i = 0; i < count; ++i) {
-          line.ydata[static_cast<qsizetype>(start + i)] = channel[start + i];
+          line.ydata[static_cast<qsizetype>(start + i)] = channel[static_cast<qsizetype>(start + i)];
         }
       }
     } else {
-      for (size_t i = 0; i < channel.size(); ++i) {
-        line.ydata.push_back(channel[i]);
-      }
+      // Shares the channel's buffer; editing ydata through the handle API detaches it.
+      line.ydata = channel;
     }
 
     if (!data.isAudio || data.sampleRate <= 0) {
-      line.xdata.reserve(static_cast<qsizetype>(channel.size()));
-      for (size_t i = 0; i < channel.size(); ++i) {
+      line.xdata.reserve(channel.size());
+      for (size_t i = 0; i < channelSize; ++i) {
         line.xdata.push_back(static_cast<double>(i + 1));
       }
     }
@@ -336,12 +353,18 @@ void GraphicsFigureModel::syncLineData(const SignalData& data) {
     double ymin = -1.0;
     double ymax = 1.0;
     for (const auto& line : lines_) {
-      if (line.common.parentId != axes.common.id || line.ydata.isEmpty()) {
+      if (line.common.parentId != axes.common.id) {
+        continue;
+      }
+      const bool sparseLine = line.logicalChannel >= 0 && line.logicalChannel < static_cast<int>(data.channels.size()) &&
+                              data.channels[static_cast<size_t>(line.logicalChannel)].sparse;
+      if (line.ydata.isEmpty() && !sparseLine) {
         continue;
       }
       if (data.isAudio && data.sampleRate > 0) {
         const double lineXMin = data.startTimeSec;
-        const int sampleCount = line.ydata.size();
+        const int sampleCount = sparseLine ? channelLength(data.channels[static_cast<size_t>(line.logicalChannel)])
+                                           : static_cast<int>(line.ydata.size());
         const double lineXMax = data.startTimeSec +
                                 static_cast<double>(std::max(0, sampleCount - 1)) /
                                     static_cast<double>(data.sampleRate);
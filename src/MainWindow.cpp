@@ -17,6 +17,9 @@
 #include <QAction>
 #include <QApplication>
 #include <QCoreApplication>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDeadlineTimer>
 #include <QDialog>
 #include <QDialogButtonBox>
 #include <QDir>
@@ -36,8 +39,6 @@
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
-#include <QMutex>
-#include <QMutexLocker>
 #include <QIODevice>
 #include <QPlainTextEdit>
 #include <QPermissions>
@@ -50,14 +51,21 @@
 #include <QStatusBar>
 #include <QSplitter>
 #include <QTextStream>
+#include <QThread>
 #include <QTreeWidget>
 #include <QVBoxLayout>
 #include <QWidget>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <unordered_set>
 
 namespace {
@@ -69,22 +77,61 @@ constexpr uint16_t kDisplayTypebitHandle = 0x4000;
 constexpr int kDefaultAsyncCapturePollMs = 300;
 constexpr int kMinAsyncCapturePollMs = 5;
 constexpr int kMaxAsyncCapturePollMs = 5000;
-}
-
+// Audio an async capture ring holds; the capture worker drains it every few ms, so this
+// only has to absorb scheduling stalls.
+constexpr int kCaptureRingMs = 4000;
+constexpr int kMinCaptureWakeMs = 2;
+constexpr int kMaxCaptureWakeMs = 20;
+constexpr int kMinWelchSegmentLog2 = 8;
+constexpr int kMaxWelchSegmentLog2 = 16;
+// Transform size cap when the overlay takes one FFT over the view; longer views
+// average transforms of this size.
+constexpr int kMaxSingleFftLog2 = 20;
+// Audio longer than this (samples per channel, ~6 min at 44.1 kHz) opens in a paged graph
+// that fetches only the samples around the visible range.
+constexpr int kPagedGraphMinSamples = 1 << 24;
+// Interval at which the destructor serves queued backend calls while the eval thread winds down.
+constexpr int kShutdownDrainMs = 10;
+// Line ydata values shown in the variable browser's handle member preview.
+constexpr int kHandleSnapshotPreviewValues = 64;
+}
+
+// Fixed-capacity single-producer/single-consumer ring between the audio input (writer)
+// and one reader calling drain(): the session's CaptureWorker thread for async
+// recordings, or the GUI thread once capture has ended for a synchronous record().
+// Only whole frames enter the ring; frames that arrive while it is full are dropped
+// rather than blocking the audio thread, and counted.
 class AudioCaptureSink final : public QIODevice {
 public:
-  explicit AudioCaptureSink(QObject* parent = nullptr) : QIODevice(parent) {}
+  AudioCaptureSink(qsizetype capacityBytes, int bytesPerFrame, QObject* parent = nullptr)
+      : QIODevice(parent),
+        frameBytes_(std::max(1, bytesPerFrame)),
+        capacity_(std::max<qsizetype>(frameBytes_, capacityBytes - capacityBytes % frameBytes_)),
+        ring_(static_cast<size_t>(capacity_)),
+        partial_(static_cast<size_t>(frameBytes_)) {}
 
   bool open(OpenMode mode) override {
-    data_.clear();
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    partialBytes_ = 0;
+    droppedFrames_.store(0, std::memory_order_relaxed);
     return QIODevice::open(mode | QIODevice::WriteOnly);
   }
 
-  QByteArray snapshot() const {
-    QMutexLocker locker(&mutex_);
-    return data_;
+  // Replaces `out` with every byte written since the previous drain (whole frames).
+  qsizetype drain(QByteArray& out) {
+    const quint64 tail = tail_.load(std::memory_order_relaxed);
+    const quint64 head = head_.load(std::memory_order_acquire);
+    const qsizetype count = static_cast<qsizetype>(head - tail);
+    out.resize(count);
+    copyOut(tail, out.data(), count);
+    tail_.store(head, std::memory_order_release);
+    return count;
   }
 
+  // Frames discarded because the ring was full; safe to read from any thread.
+  quint64 droppedFrames() const { return droppedFrames_.load(std::memory_order_relaxed); }
+
 protected:
   qint64 readData(char*, qint64) override { return -1; }
 
@@ -92,42 +139,180 @@ protected:
     if (!data || len <= 0) {
       return 0;
     }
-    QMutexLocker locker(&mutex_);
-    data_.append(data, static_cast<qsizetype>(len));
+    qint64 used = 0;
+    if (partialBytes_ > 0) {
+      const qint64 n = std::min<qint64>(len, frameBytes_ - partialBytes_);
+      std::memcpy(partial_.data() + partialBytes_, data, static_cast<size_t>(n));
+      partialBytes_ += static_cast<int>(n);
+      used = n;
+      if (partialBytes_ < frameBytes_) {
+        return len;
+      }
+      pushFrames(partial_.data(), frameBytes_);
+      partialBytes_ = 0;
+    }
+    const qint64 whole = (len - used) - (len - used) % frameBytes_;
+    pushFrames(data + used, whole);
+    used += whole;
+    partialBytes_ = static_cast<int>(len - used);
+    std::memcpy(partial_.data(), data + used, static_cast<size_t>(partialBytes_));
     return len;
   }
 
 private:
-  mutable QMutex mutex_;
-  QByteArray data_;
+  void pushFrames(const char* data, qint64 len) {
+    const quint64 head = head_.load(std::memory_order_relaxed);
+    const quint64 tail = tail_.load(std::memory_order_acquire);
+    const qint64 space = capacity_ - static_cast<qint64>(head - tail);
+    const qint64 n = std::max<qint64>(0, std::min(len, space - space % frameBytes_));
+    if (n < len) {
+      droppedFrames_.fetch_add(static_cast<quint64>((len - n) / frameBytes_), std::memory_order_relaxed);
+    }
+    if (n == 0) {
+      return;
+    }
+    const qsizetype at = static_cast<qsizetype>(head % static_cast<quint64>(capacity_));
+    const qsizetype first = std::min<qsizetype>(n, capacity_ - at);
+    std::memcpy(ring_.data() + at, data, static_cast<size_t>(first));
+    std::memcpy(ring_.data(), data + first, static_cast<size_t>(n - first));
+    head_.store(head + static_cast<quint64>(n), std::memory_order_release);
+  }
+
+  void copyOut(quint64 from, char* out, qsizetype count) const {
+    const qsizetype at = static_cast<qsizetype>(from % static_cast<quint64>(capacity_));
+    const qsizetype first = std::min<qsizetype>(count, capacity_ - at);
+    std::memcpy(out, ring_.data() + at, static_cast<size_t>(first));
+    std::memcpy(out + first, ring_.data(), static_cast<size_t>(count - first));
+  }
+
+  const int frameBytes_;
+  const qsizetype capacity_;
+  std::vector<char> ring_;
+  // Bytes of a frame split across writeData() calls; touched by the writer only.
+  std::vector<char> partial_;
+  int partialBytes_ = 0;
+  // Monotonic byte counters; head_ is advanced by the writer, tail_ by drain().
+  std::atomic<quint64> head_{0};
+  std::atomic<quint64> tail_{0};
+  std::atomic<quint64> droppedFrames_{0};
 };
 
-namespace {
+// Read-only PCM for play() handles: a chain of single passes, each read `repeatCount`
+// times in a row, so memory does not grow with the repeat count. More passes can be
+// appended while the sink is reading.
+class LoopingPcmSource final : public QIODevice {
+public:
+  explicit LoopingPcmSource(QObject* parent = nullptr) : QIODevice(parent) {}
 
-double decodeAudioSample(QAudioFormat::SampleFormat sampleFormat, const char* ptr) {
-  switch (sampleFormat) {
-    case QAudioFormat::UInt8: {
-      const auto sample = static_cast<unsigned char>(*ptr);
-      return (static_cast<double>(sample) - 128.0) / 128.0;
-    }
-    case QAudioFormat::Int16: {
-      qint16 sample = 0;
-      std::memcpy(&sample, ptr, sizeof(sample));
-      return std::clamp(static_cast<double>(sample) / 32768.0, -1.0, 1.0);
+  // Unbuffered so pos() is the byte the sink has pulled up to.
+  bool open(OpenMode mode) override { return QIODevice::open(mode | QIODevice::Unbuffered); }
+  bool isSequential() const override { return false; }
+  qint64 size() const override { return totalBytes_; }
+
+  void append(const QByteArray& pass, int repeatCount) {
+    if (pass.isEmpty() || repeatCount <= 0) {
+      return;
     }
-    case QAudioFormat::Int32: {
-      qint32 sample = 0;
-      std::memcpy(&sample, ptr, sizeof(sample));
-      return std::clamp(static_cast<double>(sample) / 2147483648.0, -1.0, 1.0);
+    items_.push_back({pass, repeatCount});
+    totalBytes_ += static_cast<qint64>(pass.size()) * repeatCount;
+    totalPasses_ += repeatCount;
+  }
+
+  int totalPasses() const { return totalPasses_; }
+
+  // Passes fully read by the time the reader reaches `bytePos`.
+  int passesCompletedAt(qint64 bytePos) const {
+    int passes = 0;
+    for (const Item& item : items_) {
+      const qint64 itemBytes = static_cast<qint64>(item.pass.size()) * item.repeatCount;
+      if (bytePos < itemBytes) {
+        return passes + static_cast<int>(bytePos / item.pass.size());
+      }
+      bytePos -= itemBytes;
+      passes += item.repeatCount;
     }
-    case QAudioFormat::Float: {
-      float sample = 0.0f;
-      std::memcpy(&sample, ptr, sizeof(sample));
-      return std::clamp(static_cast<double>(sample), -1.0, 1.0);
+    return passes;
+  }
+
+protected:
+  qint64 readData(char* data, qint64 maxlen) override {
+    qint64 offset = pos();
+    qint64 copied = 0;
+    for (const Item& item : items_) {
+      const qint64 passBytes = item.pass.size();
+      const qint64 itemBytes = passBytes * item.repeatCount;
+      if (offset >= itemBytes) {
+        offset -= itemBytes;
+        continue;
+      }
+      while (copied < maxlen && offset < itemBytes) {
+        const qint64 inPass = offset % passBytes;
+        const qint64 n = std::min(maxlen - copied, passBytes - inPass);
+        std::memcpy(data + copied, item.pass.constData() + inPass, static_cast<size_t>(n));
+        copied += n;
+        offset += n;
+      }
+      if (copied >= maxlen) {
+        break;
+      }
+      offset = 0;
     }
+    return copied;
+  }
+
+  qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+  struct Item {
+    QByteArray pass;
+    int repeatCount = 1;
+  };
+
+  std::vector<Item> items_;
+  qint64 totalBytes_ = 0;
+  int totalPasses_ = 0;
+};
+
+namespace {
+
+// Decodes `frames` capture frames into `out` (resized to frames * outChannels): mono
+// output averages the capture channels, otherwise channel k reads capture channel k
+// (the last one when the capture has fewer). `scratch` holds the decoded capture when
+// channels have to be remixed; formats the kernels do not cover decode as silence.
+void decodeCaptureFrames(QAudioFormat::SampleFormat sampleFormat,
+                         const char* data,
+                         qsizetype frames,
+                         int captureChannels,
+                         int outChannels,
+                         std::vector<float>& scratch,
+                         std::vector<float>& out) {
+  const size_t inSamples = static_cast<size_t>(frames) * static_cast<size_t>(captureChannels);
+  out.resize(static_cast<size_t>(frames) * static_cast<size_t>(outChannels));
+  PcmFormat format = PcmFormat::Int16;
+  switch (sampleFormat) {
+    case QAudioFormat::UInt8:
+      format = PcmFormat::UInt8;
+      break;
+    case QAudioFormat::Int16:
+      format = PcmFormat::Int16;
+      break;
+    case QAudioFormat::Int32:
+      format = PcmFormat::Int32;
+      break;
+    case QAudioFormat::Float:
+      format = PcmFormat::Float;
+      break;
     default:
-      return 0.0;
+      std::fill(out.begin(), out.end(), 0.0f);
+      return;
   }
+  if (captureChannels == outChannels) {
+    decodePcm(format, data, inSamples, out.data());
+    return;
+  }
+  scratch.resize(inSamples);
+  decodePcm(format, data, inSamples, scratch.data());
+  remixInterleaved(scratch.data(), static_cast<size_t>(frames), captureChannels, outChannels, out.data());
 }
 
 QString historyFilePath() {
@@ -192,25 +377,27 @@ std::optional<QVector<double>> numericVectorFromAuxObj(AuxObj obj) {
   return values;
 }
 
-QByteArray buildAudioPcm16(const SignalData& sig, int& outChannelCount, int& outTotalFrames) {
+QByteArray buildAudioPcm16(const SignalView& sig, int& outChannelCount, int& outTotalFrames) {
   outChannelCount = std::min<int>(2, static_cast<int>(sig.channels.size()));
-  const int dataFrames = sig.channels.empty() ? 0 : static_cast<int>(sig.channels.front().samples.size());
   const int sampleRate = sig.sampleRate > 0 ? sig.sampleRate : 22050;
   const int startOffsetFrames = std::max(0, static_cast<int>(std::llround(sig.startTimeSec * sampleRate)));
-  outTotalFrames = startOffsetFrames + dataFrames;
+  outTotalFrames = startOffsetFrames + sig.totalSamples;
 
-  QByteArray pcm;
-  pcm.resize(outTotalFrames * outChannelCount * static_cast<int>(sizeof(qint16)));
+  // Gaps between segments and the leading offset stay zero (silence); only the
+  // engine-owned segment buffers are read.
+  QByteArray pcm(outTotalFrames * outChannelCount * static_cast<int>(sizeof(qint16)), '\0');
   auto* out = reinterpret_cast<qint16*>(pcm.data());
-  for (int i = 0; i < outTotalFrames; ++i) {
-    const int di = i - startOffsetFrames;
-    for (int c = 0; c < outChannelCount; ++c) {
-      const auto& src = sig.channels[static_cast<size_t>(c)].samples;
-      double v = 0.0;
-      if (di >= 0 && di < static_cast<int>(src.size())) {
-        v = std::clamp(src[static_cast<size_t>(di)], -1.0, 1.0);
+  for (int c = 0; c < outChannelCount; ++c) {
+    for (const auto& seg : sig.channels[static_cast<size_t>(c)].segments) {
+      if (!seg.samples) {
+        continue;
+      }
+      qint16* dst = out + static_cast<qsizetype>(startOffsetFrames + seg.startSample) * outChannelCount + c;
+      for (int i = 0; i < seg.length; ++i) {
+        const double v = std::clamp(seg.samples[i], -1.0, 1.0);
+        *dst = static_cast<qint16>(std::lrint(v * 32767.0));
+        dst += outChannelCount;
       }
-      *out++ = static_cast<qint16>(std::lrint(v * 32767.0));
     }
   }
   return pcm;
@@ -572,23 +759,51 @@ std::optional<SignalData> signalDataFromNumericDisplay(const QString& text) {
   return data;
 }
 
+// With background evaluation the engine invokes these backends from the eval
+// thread; the widgets and audio objects they touch live on the GUI thread.
+template <typename Result, typename Fn>
+Result onGuiThread(MainWindow* window, Fn fn) {
+  if (QThread::currentThread() == window->thread()) {
+    return fn();
+  }
+  Result result{};
+  QMetaObject::invokeMethod(
+      window,
+      [&]() {
+        // During teardown the window serves queued calls only to release the eval thread.
+        if (window->isShuttingDown()) {
+          return;
+        }
+        window->setBackendCallActive(true);
+        result = fn();
+        window->setBackendCallActive(false);
+      },
+      Qt::BlockingQueuedConnection);
+  return result;
+}
+
 int auxlab2GraphicsNotify(void* userdata, const auxGraphicsEvent& event, std::string& errstr) {
   auto* window = static_cast<MainWindow*>(userdata);
   if (!window) {
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 1;
   }
-  return window->handleGraphicsBackendEvent(event, errstr) ? 0 : 1;
+  if (window->backendCallInterrupted(errstr)) {
+    return 1;
+  }
+  return onGuiThread<bool>(window, [&]() {
+    return window->handleGraphicsBackendEvent(event, errstr);
+  }) ? 0 : 1;
 }
 
 std::uint64_t auxlab2CurrentFigureId(void* userdata) {
   auto* window = static_cast<MainWindow*>(userdata);
-  return window ? window->currentGraphicsFigureId() : 0;
+  return window ? onGuiThread<std::uint64_t>(window, [&]() { return window->currentGraphicsFigureId(); }) : 0;
 }
 
 std::uint64_t auxlab2CurrentAxesId(void* userdata) {
   auto* window = static_cast<MainWindow*>(userdata);
-  return window ? window->currentGraphicsAxesId() : 0;
+  return window ? onGuiThread<std::uint64_t>(window, [&]() { return window->currentGraphicsAxesId(); }) : 0;
 }
 
 std::uint64_t auxlab2CreateFigure(void* userdata, std::string& errstr) {
@@ -597,7 +812,12 @@ std::uint64_t auxlab2CreateFigure(void* userdata, std::string& errstr) {
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 0;
   }
-  return window->createGraphicsFigure(errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsFigure(errstr);
+  });
 }
 
 std::uint64_t auxlab2FigureFromHandle(void* userdata, std::uint64_t handleId, std::string& errstr) {
@@ -606,7 +826,12 @@ std::uint64_t auxlab2FigureFromHandle(void* userdata, std::uint64_t handleId, st
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 0;
   }
-  return window->createGraphicsFigureFromHandle(handleId, errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsFigureFromHandle(handleId, errstr);
+  });
 }
 
 std::uint64_t auxlab2FigureAtPos(void* userdata, const double pos[4], std::string& errstr) {
@@ -619,7 +844,12 @@ std::uint64_t auxlab2FigureAtPos(void* userdata, const double pos[4], std::strin
     errstr = "figure() requires a position vector.";
     return 0;
   }
-  return window->createGraphicsFigureAtPos({pos[0], pos[1], pos[2], pos[3]}, errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsFigureAtPos({pos[0], pos[1], pos[2], pos[3]}, errstr);
+  });
 }
 
 std::uint64_t auxlab2NamedFigure(void* userdata, const char* sourceName, std::string& errstr) {
@@ -632,7 +862,12 @@ std::uint64_t auxlab2NamedFigure(void* userdata, const char* sourceName, std::st
     errstr = "figure() requires a non-empty source name.";
     return 0;
   }
-  return window->createGraphicsNamedFigure(sourceName, errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsNamedFigure(sourceName, errstr);
+  });
 }
 
 std::uint64_t auxlab2Plot(void* userdata,
@@ -646,11 +881,16 @@ std::uint64_t auxlab2Plot(void* userdata,
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 0;
   }
-  return window->createGraphicsPlot(targetHandleId,
-                                    obj,
-                                    sourceExpr ? std::string(sourceExpr) : std::string(),
-                                    styleText ? std::string(styleText) : std::string(),
-                                    errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsPlot(targetHandleId,
+                                      obj,
+                                      sourceExpr ? std::string(sourceExpr) : std::string(),
+                                      styleText ? std::string(styleText) : std::string(),
+                                      errstr);
+  });
 }
 
 std::uint64_t auxlab2Line(void* userdata,
@@ -663,7 +903,12 @@ std::uint64_t auxlab2Line(void* userdata,
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 0;
   }
-  return window->createGraphicsLine(targetHandleId, xObj, yObj, errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsLine(targetHandleId, xObj, yObj, errstr);
+  });
 }
 
 std::uint64_t auxlab2CreateAxes(void* userdata, std::string& errstr) {
@@ -672,7 +917,12 @@ std::uint64_t auxlab2CreateAxes(void* userdata, std::string& errstr) {
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 0;
   }
-  return window->createGraphicsAxes(errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsAxes(errstr);
+  });
 }
 
 std::uint64_t auxlab2AxesFromHandle(void* userdata, std::uint64_t handleId, std::string& errstr) {
@@ -681,7 +931,12 @@ std::uint64_t auxlab2AxesFromHandle(void* userdata, std::uint64_t handleId, std:
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 0;
   }
-  return window->createGraphicsAxesFromHandle(handleId, errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsAxesFromHandle(handleId, errstr);
+  });
 }
 
 std::uint64_t auxlab2AxesAtPos(void* userdata, const double pos[4], std::string& errstr) {
@@ -694,7 +949,12 @@ std::uint64_t auxlab2AxesAtPos(void* userdata, const double pos[4], std::string&
     errstr = "axes() requires a position vector.";
     return 0;
   }
-  return window->createGraphicsAxesAtPos({pos[0], pos[1], pos[2], pos[3]}, errstr);
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<std::uint64_t>(window, [&]() {
+    return window->createGraphicsAxesAtPos({pos[0], pos[1], pos[2], pos[3]}, errstr);
+  });
 }
 
 int auxlab2DeleteHandle(void* userdata, std::uint64_t handleId, std::string& errstr) {
@@ -703,7 +963,12 @@ int auxlab2DeleteHandle(void* userdata, std::uint64_t handleId, std::string& err
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 0;
   }
-  return window->deleteGraphicsHandle(handleId, errstr) ? 1 : 0;
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<bool>(window, [&]() {
+    return window->deleteGraphicsHandle(handleId, errstr);
+  }) ? 1 : 0;
 }
 
 int auxlab2RepaintHandle(void* userdata, std::uint64_t handleId, std::string& errstr) {
@@ -712,7 +977,12 @@ int auxlab2RepaintHandle(void* userdata, std::uint64_t handleId, std::string& er
     errstr = "auxlab2 graphics backend has no MainWindow owner.";
     return 0;
   }
-  return window->repaintGraphicsHandle(handleId, errstr) ? 1 : 0;
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<bool>(window, [&]() {
+    return window->repaintGraphicsHandle(handleId, errstr);
+  }) ? 1 : 0;
 }
 
 int auxlab2StartPlayback(void* userdata,
@@ -726,7 +996,12 @@ int auxlab2StartPlayback(void* userdata,
     errstr = "auxlab2 playback backend has no MainWindow owner.";
     return 0;
   }
-  return window->startPlaybackHandle(handleId, obj, repeatCount, reuseExistingHandle != 0, errstr) ? 1 : 0;
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<bool>(window, [&]() {
+    return window->startPlaybackHandle(handleId, obj, repeatCount, reuseExistingHandle != 0, errstr);
+  }) ? 1 : 0;
 }
 
 int auxlab2ControlPlayback(void* userdata,
@@ -738,7 +1013,12 @@ int auxlab2ControlPlayback(void* userdata,
     errstr = "auxlab2 playback backend has no MainWindow owner.";
     return 0;
   }
-  return window->controlPlaybackHandle(handleId, command, errstr) ? 1 : 0;
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<bool>(window, [&]() {
+    return window->controlPlaybackHandle(handleId, command, errstr);
+  }) ? 1 : 0;
 }
 
 int auxlab2RecordAudio(void* userdata,
@@ -753,7 +1033,12 @@ int auxlab2RecordAudio(void* userdata,
     errstr = "auxlab2 recording backend has no MainWindow owner.";
     return 0;
   }
-  return window->recordAudio(deviceId, sampleRate, channelCount, durationMs, result, errstr) ? 1 : 0;
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<bool>(window, [&]() {
+    return window->recordAudio(deviceId, sampleRate, channelCount, durationMs, result, errstr);
+  }) ? 1 : 0;
 }
 
 int auxlab2StartAsyncRecord(void* userdata,
@@ -765,7 +1050,12 @@ int auxlab2StartAsyncRecord(void* userdata,
     errstr = "auxlab2 async recording backend has no MainWindow owner.";
     return 0;
   }
-  return window->startAsyncRecordHandle(handleId, spec, errstr) ? 1 : 0;
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<bool>(window, [&]() {
+    return window->startAsyncRecordHandle(handleId, spec, errstr);
+  }) ? 1 : 0;
 }
 
 int auxlab2ControlAsyncRecord(void* userdata,
@@ -777,10 +1067,216 @@ int auxlab2ControlAsyncRecord(void* userdata,
     errstr = "auxlab2 async recording backend has no MainWindow owner.";
     return 0;
   }
-  return window->controlAsyncRecordHandle(handleId, command, errstr) ? 1 : 0;
+  if (window->backendCallInterrupted(errstr)) {
+    return 0;
+  }
+  return onGuiThread<bool>(window, [&]() {
+    return window->controlAsyncRecordHandle(handleId, command, errstr);
+  }) ? 1 : 0;
 }
 }  // namespace
 
+// Processes one async recording's capture on its own thread: drains the sink's ring,
+// decodes and mixes the frames, resamples them and writes the result straight into
+// fixed-size blocks of blockFrames frames. The GUI thread only collects finished blocks
+// (takeBlocks) and hands them to the AUX callback, so a busy UI delays callbacks but not
+// conversion. Blocks are allocated as they are needed; delivered blocks come back through
+// recycleBlock() and are refilled, so a steady recording allocates no block storage. The
+// pool of idle blocks is capped in bytes, so long block_ms settings do not hold on to
+// more than kMaxPooledBlockBytes of spare storage.
+class CaptureWorker {
+public:
+  struct Format {
+    QAudioFormat::SampleFormat sampleFormat = QAudioFormat::Unknown;
+    int bytesPerSample = 0;
+    int captureChannels = 0;
+    int channelCount = 0;
+    qsizetype blockFrames = 1;
+  };
+
+  // `blocksReady` runs on the worker thread, at most once between takeBlocks() calls.
+  CaptureWorker(AudioCaptureSink* sink,
+                const Format& format,
+                std::unique_ptr<StreamResampler> resampler,
+                int wakeMs,
+                std::function<void()> blocksReady)
+      : sink_(sink),
+        format_(format),
+        blockSamples_(static_cast<size_t>(format.blockFrames) * static_cast<size_t>(format.channelCount)),
+        resampler_(std::move(resampler)),
+        wake_(wakeMs),
+        blocksReady_(std::move(blocksReady)),
+        maxFreeBlocks_(std::min(kMaxFreeBlocks, kMaxPooledBlockBytes / std::max<size_t>(1, blockSamples_ * sizeof(double)))) {
+    current_ = takeFreeBlockLocked();
+  }
+
+  ~CaptureWorker() { stopThread(); }
+
+  void start() {
+    thread_ = std::thread([this]() { run(); });
+  }
+
+  // Stops the thread, then converts what is still in the ring and flushes the
+  // resampler. Frames short of a whole block are moved to `remainder`.
+  void finish(std::vector<double>& remainder) {
+    stopThread();
+    process(true);
+    current_.resize(filled_);
+    remainder = std::move(current_);
+    current_.clear();
+    filled_ = 0;
+  }
+
+  // Appends the finished blocks to `out`. Returns false (with `err`) once, on the first
+  // call after conversion failed; the worker produces nothing further.
+  bool takeBlocks(std::deque<std::vector<double>>& out, std::string& err) {
+    notified_.store(false, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (out.empty()) {
+      out.swap(ready_);
+    } else {
+      for (auto& block : ready_) {
+        out.push_back(std::move(block));
+      }
+      ready_.clear();
+    }
+    if (!error_.empty()) {
+      err = std::move(error_);
+      error_.clear();
+      return false;
+    }
+    return true;
+  }
+
+  qsizetype framesProduced() const { return framesProduced_.load(std::memory_order_relaxed); }
+
+  // Returns a delivered block's storage for reuse.
+  void recycleBlock(std::vector<double>&& block) {
+    if (block.capacity() < blockSamples_) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (freeBlocks_.size() < maxFreeBlocks_) {
+      freeBlocks_.push_back(std::move(block));
+    }
+  }
+
+private:
+  static constexpr size_t kMaxFreeBlocks = 64;
+  static constexpr size_t kMaxPooledBlockBytes = size_t{16} << 20;
+
+  std::vector<double> takeFreeBlockLocked() {
+    if (freeBlocks_.empty()) {
+      return std::vector<double>(blockSamples_);
+    }
+    std::vector<double> block = std::move(freeBlocks_.back());
+    freeBlocks_.pop_back();
+    block.resize(blockSamples_);
+    return block;
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+      lock.unlock();
+      process(false);
+      lock.lock();
+      wakeup_.wait_for(lock, wake_, [this]() { return stopping_; });
+    }
+  }
+
+  void stopThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wakeup_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  void process(bool endOfInput) {
+    if (failed_) {
+      return;
+    }
+    const qsizetype bytesPerFrame = static_cast<qsizetype>(format_.bytesPerSample) * format_.captureChannels;
+    const qsizetype frames = sink_->drain(bytes_) / bytesPerFrame;
+    std::string err;
+    convertedFloat_.clear();
+    decodeCaptureFrames(format_.sampleFormat,
+                        bytes_.constData(),
+                        frames,
+                        format_.captureChannels,
+                        format_.channelCount,
+                        decodedFloat_,
+                        captureFloat_);
+    if (!resampler_->process(captureFloat_.data(), static_cast<long>(frames), convertedFloat_, err) ||
+        (endOfInput && !resampler_->finish(convertedFloat_, err))) {
+      failed_ = true;
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = err;
+      return;
+    }
+    if (convertedFloat_.empty()) {
+      return;
+    }
+
+    bool anyReady = false;
+    const size_t count = convertedFloat_.size();
+    for (size_t i = 0; i < count;) {
+      const size_t n = std::min(count - i, blockSamples_ - filled_);
+      decodePcm(PcmFormat::Float, convertedFloat_.data() + i, n, current_.data() + filled_);
+      filled_ += n;
+      i += n;
+      if (filled_ == blockSamples_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_.push_back(std::move(current_));
+        current_ = takeFreeBlockLocked();
+        filled_ = 0;
+        anyReady = true;
+      }
+    }
+    framesProduced_.fetch_add(static_cast<qsizetype>(count / static_cast<size_t>(format_.channelCount)),
+                              std::memory_order_relaxed);
+    if (!anyReady) {
+      return;
+    }
+    if (!endOfInput && blocksReady_ && !notified_.exchange(true, std::memory_order_relaxed)) {
+      blocksReady_();
+    }
+  }
+
+  AudioCaptureSink* sink_ = nullptr;
+  const Format format_;
+  const size_t blockSamples_;
+  std::unique_ptr<StreamResampler> resampler_;
+  const std::chrono::milliseconds wake_;
+  std::function<void()> blocksReady_;
+  // Idle blocks kept for reuse: kMaxFreeBlocks, or fewer when blocks are large.
+  const size_t maxFreeBlocks_;
+
+  // Used by the worker thread only (or by finish() after the thread has stopped).
+  QByteArray bytes_;
+  std::vector<float> decodedFloat_;
+  std::vector<float> captureFloat_;
+  std::vector<float> convertedFloat_;
+  // The block being filled and how many of its samples are written.
+  std::vector<double> current_;
+  size_t filled_ = 0;
+  bool failed_ = false;
+
+  std::atomic<qsizetype> framesProduced_{0};
+  std::atomic<bool> notified_{false};
+  std::mutex mutex_;
+  std::condition_variable wakeup_;
+  bool stopping_ = false;
+  std::deque<std::vector<double>> ready_;
+  std::vector<std::vector<double>> freeBlocks_;
+  std::string error_;
+  std::thread thread_;
+};
+
 MainWindow::MainWindow() {
   if (!engine_.init()) {
     QMessageBox::critical(nullptr, "AUX", "Failed to initialize AUX engine.");
@@ -837,6 +1333,16 @@ MainWindow::MainWindow() {
 }
 
 MainWindow::~MainWindow() {
+  if (evalThread_) {
+    // A running eval fails its next backend call; one already parked in a blocking
+    // call to this thread is released by serving the queued call here.
+    shuttingDown_ = true;
+    evalInterruptRequested_.store(true);
+    evalThread_->quit();
+    while (!evalThread_->wait(QDeadlineTimer(kShutdownDrainMs))) {
+      QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+    }
+  }
   engine_.clearGraphicsBackend();
   engine_.clearPlaybackBackend();
   if (varAudioSink_) {
@@ -846,8 +1352,8 @@ MainWindow::~MainWindow() {
     if (entry.second.sink) {
       entry.second.sink->stop();
     }
-    if (entry.second.buffer) {
-      entry.second.buffer->close();
+    if (entry.second.source) {
+      entry.second.source->close();
     }
   }
 }
@@ -969,7 +1475,7 @@ std::uint64_t MainWindow::createGraphicsPlot(std::uint64_t targetHandleId,
 
   const QString expr = QString::fromStdString(sourceExpr);
   if (!expr.isEmpty() && !sig->isAudio && !sig->channels.empty()) {
-    const int expectedLength = static_cast<int>(sig->channels.front().samples.size());
+    const int expectedLength = channelLength(sig->channels.front());
     if (const auto xdata = extractRangeXData(expr, expectedLength); xdata.has_value()) {
       targetWindow->applyXDataToAllLines(*xdata);
     }
@@ -1437,8 +1943,12 @@ void MainWindow::buildMenus() {
 
 void MainWindow::connectSignals() {
   connect(commandBox_, &CommandConsole::commandSubmitted, this, [this](const QString& cmd) {
+    if (backgroundEval_) {
+      commandBox_->appendExecutionResult({});
+    }
     runCommand(cmd);
   });
+  connect(commandBox_, &CommandConsole::interruptRequested, this, &MainWindow::interruptEvaluation);
   connect(commandBox_, &CommandConsole::historyNavigateRequested, this, &MainWindow::navigateHistoryFromCommand);
   connect(commandBox_, &CommandConsole::reverseSearchRequested, this, &MainWindow::reverseSearchFromCommand);
   connect(audioVariableBox_, &QWidget::customContextMenuRequested, this, [this](const QPoint& pos) {
@@ -1450,6 +1960,9 @@ void MainWindow::connectSignals() {
 
   connect(openUdfFileAction_, &QAction::triggered, this, &MainWindow::openUdfFile);
   connect(openRecentQuickAction_, &QAction::triggered, this, [this]() {
+    if (rejectWhileEngineBusy()) {
+      return;
+    }
     if (recentUdfFiles_.isEmpty()) {
       statusBar()->showMessage("No recent UDF files.", 2000);
       return;
@@ -1559,6 +2072,13 @@ void MainWindow::connectSignals() {
 }
 
 void MainWindow::closeEvent(QCloseEvent* event) {
+  if (evalInFlight_) {
+    closePending_ = true;
+    evalInterruptRequested_.store(true);
+    statusBar()->showMessage("Waiting for the running command to finish before closing...");
+    event->ignore();
+    return;
+  }
   closeAllScopedWindows();
   if (debugWindow_) {
     debugWindow_->close();
@@ -1680,6 +2200,21 @@ void MainWindow::loadPersistedRuntimeSettings() {
                                        .toInt(),
                                    kMinAsyncCapturePollMs,
                                    kMaxAsyncCapturePollMs);
+  backgroundEval_ = settings.value("runtime_settings/background_eval", false).toBool();
+  welchSpectrum_ = settings.value("runtime_settings/fft_welch", false).toBool();
+  const int segmentLog2 = std::clamp(settings.value("runtime_settings/fft_segment_log2", 12).toInt(),
+                                     kMinWelchSegmentLog2,
+                                     kMaxWelchSegmentLog2);
+  welchOptions_.segmentSize = 1 << segmentLog2;
+  welchOptions_.overlap = std::clamp(settings.value("runtime_settings/fft_overlap_percent", 50).toInt(), 0, 90) / 100.0;
+  welchOptions_.window = static_cast<SpectrumWindow>(
+      std::clamp(settings.value("runtime_settings/fft_window", static_cast<int>(SpectrumWindow::Hann)).toInt(),
+                 static_cast<int>(SpectrumWindow::Rectangular),
+                 static_cast<int>(SpectrumWindow::Hamming)));
+  recordResampleQuality_ = static_cast<ResampleQuality>(
+      std::clamp(settings.value("runtime_settings/record_resample_quality", static_cast<int>(ResampleQuality::Medium)).toInt(),
+                 static_cast<int>(ResampleQuality::Best),
+                 static_cast<int>(ResampleQuality::Linear)));
   if (!settings.contains("runtime_settings/sample_rate")) {
     return;
   }
@@ -1715,6 +2250,16 @@ void MainWindow::savePersistedRuntimeSettings() const {
   settings.setValue("runtime_settings/display_limit_bytes", cfg.displayLimitBytes);
   settings.setValue("runtime_settings/display_limit_str", cfg.displayLimitStr);
   settings.setValue("runtime_settings/async_capture_poll_ms", asyncCapturePollMs_);
+  settings.setValue("runtime_settings/background_eval", backgroundEval_);
+  settings.setValue("runtime_settings/fft_welch", welchSpectrum_);
+  int segmentLog2 = 0;
+  while ((1 << (segmentLog2 + 1)) <= welchOptions_.segmentSize) {
+    ++segmentLog2;
+  }
+  settings.setValue("runtime_settings/fft_segment_log2", segmentLog2);
+  settings.setValue("runtime_settings/fft_overlap_percent", static_cast<int>(std::lround(welchOptions_.overlap * 100.0)));
+  settings.setValue("runtime_settings/fft_window", static_cast<int>(welchOptions_.window));
+  settings.setValue("runtime_settings/record_resample_quality", static_cast<int>(recordResampleQuality_));
 
   QStringList paths;
   for (const std::string& p : cfg.udfPaths) {
@@ -1824,7 +2369,7 @@ void MainWindow::startWatchingCurrentUdf() {
 }
 
 bool MainWindow::reloadCurrentUdfIfStale(const QString& reason, bool forceReload) {
-  if (currentUdfFilePath_.isEmpty()) {
+  if (currentUdfFilePath_.isEmpty() || engineBusy()) {
     return false;
   }
 
@@ -1887,6 +2432,9 @@ void MainWindow::addRecentUdfFile(const QString& filePath) {
 }
 
 void MainWindow::openRecentUdf() {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   auto* action = qobject_cast<QAction*>(sender());
   if (!action) {
     return;
@@ -1927,6 +2475,9 @@ void MainWindow::openRecentUdf() {
 }
 
 void MainWindow::openUdfFile() {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   const QString filePath = QFileDialog::getOpenFileName(this, "Open UDF File", QString(), "AUX UDF (*.aux);;All Files (*.*)");
   if (filePath.isEmpty()) {
     return;
@@ -1970,6 +2521,9 @@ void MainWindow::closeUdfFile() {
 }
 
 void MainWindow::toggleBreakpointAtCursor() {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   const QString udfName = activeDebugUdfName();
   if (udfName.isEmpty()) {
     statusBar()->showMessage("Open a UDF file first.", 2000);
@@ -1990,6 +2544,9 @@ void MainWindow::toggleBreakpointAtCursor() {
 }
 
 void MainWindow::setBreakpointAtLine(int lineNumber, bool enable) {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   const QString udfName = activeDebugUdfName();
   const QString filePath = activeDebugFilePath();
   if (udfName.isEmpty() || filePath.isEmpty() || lineNumber <= 0) {
@@ -2014,6 +2571,11 @@ void MainWindow::setBreakpointAtLine(int lineNumber, bool enable) {
 }
 
 void MainWindow::runCommand(const QString& cmd, bool addToHistory) {
+  if (evalInFlight_) {
+    pendingCommands_.push_back({cmd, addToHistory});
+    statusBar()->showMessage(QString("Queued (%1 pending)").arg(pendingCommands_.size()), 2000);
+    return;
+  }
   reloadCurrentUdfIfStale("Reloaded after external edit");
   QString actual = cmd;
   lastStartedAsyncRecordHandle_ = 0;
@@ -2051,9 +2613,9 @@ void MainWindow::runCommand(const QString& cmd, bool addToHistory) {
     updateCommandPrompt();
     const QString trimmed = actual.trimmed();
     if (trimmed.endsWith(';')) {
-      commandBox_->appendExecutionResult({});
+      echoCommandResult({});
     } else {
-      commandBox_->appendExecutionResult(graphicsOutput);
+      echoCommandResult(graphicsOutput);
     }
     historyNavIndex_ = -1;
     historyDraft_.clear();
@@ -2079,18 +2641,56 @@ void MainWindow::runCommand(const QString& cmd, bool addToHistory) {
   }
 
   if (!actual.trimmed().isEmpty()) {
-    auto result = engine_.eval(actual.toStdString());
-    static const QRegularExpression kAsyncRecordAssign(
-        R"(^\s*([A-Za-z_][A-Za-z0-9_]*)\s*=\s*record\s*\(.*\)\s*\.\s*([A-Za-z_][A-Za-z0-9_]*)\s*;?\s*$)");
-    static const QRegularExpression kAsyncRecordExpr(
-        R"(^\s*record\s*\(.*\)\s*\.\s*([A-Za-z_][A-Za-z0-9_]*)\s*;?\s*$)");
-    const QRegularExpressionMatch asyncRecordMatch = kAsyncRecordAssign.match(actual.trimmed());
-    const QRegularExpressionMatch asyncRecordExprMatch = kAsyncRecordExpr.match(actual.trimmed());
-    if (result.status != static_cast<int>(auxEvalStatus::AUX_EVAL_OK) &&
-        lastStartedAsyncRecordHandle_ != 0 &&
-        asyncRecordMatch.hasMatch() &&
-        asyncRecordMatch.captured(2) == lastStartedAsyncRecordCallback_ &&
-        recordingSessions_.find(lastStartedAsyncRecordHandle_) != recordingSessions_.end()) {
+    if (backgroundEval_) {
+      startBackgroundEval(actual);
+      return;
+    }
+    finishEvaluatedCommand(actual, engine_.eval(actual.toStdString()));
+  } else {
+    updateCommandPrompt();
+    echoCommandResult({});
+    historyNavIndex_ = -1;
+    historyDraft_.clear();
+    reverseSearchActive_ = false;
+    reverseSearchTerm_.clear();
+    reverseSearchIndex_ = -1;
+  }
+
+  refreshVariables();
+  refreshDebugView();
+  reconcileScopedWindows();
+}
+
+void MainWindow::finishEvaluatedCommand(const QString& actual, EvalResult result) {
+  static const QRegularExpression kAsyncRecordAssign(
+      R"(^\s*([A-Za-z_][A-Za-z0-9_]*)\s*=\s*record\s*\(.*\)\s*\.\s*([A-Za-z_][A-Za-z0-9_]*)\s*;?\s*$)");
+  static const QRegularExpression kAsyncRecordExpr(
+      R"(^\s*record\s*\(.*\)\s*\.\s*([A-Za-z_][A-Za-z0-9_]*)\s*;?\s*$)");
+  const QRegularExpressionMatch asyncRecordMatch = kAsyncRecordAssign.match(actual.trimmed());
+  const QRegularExpressionMatch asyncRecordExprMatch = kAsyncRecordExpr.match(actual.trimmed());
+  if (result.status != static_cast<int>(auxEvalStatus::AUX_EVAL_OK) &&
+      lastStartedAsyncRecordHandle_ != 0 &&
+      asyncRecordMatch.hasMatch() &&
+      asyncRecordMatch.captured(2) == lastStartedAsyncRecordCallback_ &&
+      recordingSessions_.find(lastStartedAsyncRecordHandle_) != recordingSessions_.end()) {
+    engine_.setHandleValues(asyncRecordMatch.captured(1).toStdString(), {lastStartedAsyncRecordHandle_});
+    const auto strayCallbackVar = engine_.getScalarValue(lastStartedAsyncRecordCallback_.toStdString());
+    if (strayCallbackVar.has_value()) {
+      const auto rounded = static_cast<long long>(std::llround(*strayCallbackVar));
+      if (rounded > 0 &&
+          std::fabs(*strayCallbackVar - static_cast<double>(rounded)) < 1e-9 &&
+          static_cast<std::uint64_t>(rounded) == lastStartedAsyncRecordHandle_ &&
+          asyncRecordMatch.captured(1) != lastStartedAsyncRecordCallback_) {
+        engine_.deleteVar(lastStartedAsyncRecordCallback_.toStdString());
+      }
+    }
+    result.status = static_cast<int>(auxEvalStatus::AUX_EVAL_OK);
+    result.output = QString("audio_record handle %1").arg(lastStartedAsyncRecordHandle_).toStdString();
+  } else if (result.status == static_cast<int>(auxEvalStatus::AUX_EVAL_OK) &&
+             lastStartedAsyncRecordHandle_ != 0 &&
+             ((asyncRecordMatch.hasMatch() && asyncRecordMatch.captured(2) == lastStartedAsyncRecordCallback_) ||
+              (asyncRecordExprMatch.hasMatch() && asyncRecordExprMatch.captured(1) == lastStartedAsyncRecordCallback_))) {
+    if (asyncRecordMatch.hasMatch()) {
       engine_.setHandleValues(asyncRecordMatch.captured(1).toStdString(), {lastStartedAsyncRecordHandle_});
       const auto strayCallbackVar = engine_.getScalarValue(lastStartedAsyncRecordCallback_.toStdString());
       if (strayCallbackVar.has_value()) {
@@ -2102,54 +2702,132 @@ void MainWindow::runCommand(const QString& cmd, bool addToHistory) {
           engine_.deleteVar(lastStartedAsyncRecordCallback_.toStdString());
         }
       }
-      result.status = static_cast<int>(auxEvalStatus::AUX_EVAL_OK);
-      result.output = QString("audio_record handle %1").arg(lastStartedAsyncRecordHandle_).toStdString();
-    } else if (result.status == static_cast<int>(auxEvalStatus::AUX_EVAL_OK) &&
-               lastStartedAsyncRecordHandle_ != 0 &&
-               ((asyncRecordMatch.hasMatch() && asyncRecordMatch.captured(2) == lastStartedAsyncRecordCallback_) ||
-                (asyncRecordExprMatch.hasMatch() && asyncRecordExprMatch.captured(1) == lastStartedAsyncRecordCallback_))) {
-      if (asyncRecordMatch.hasMatch()) {
-        engine_.setHandleValues(asyncRecordMatch.captured(1).toStdString(), {lastStartedAsyncRecordHandle_});
-        const auto strayCallbackVar = engine_.getScalarValue(lastStartedAsyncRecordCallback_.toStdString());
-        if (strayCallbackVar.has_value()) {
-          const auto rounded = static_cast<long long>(std::llround(*strayCallbackVar));
-          if (rounded > 0 &&
-              std::fabs(*strayCallbackVar - static_cast<double>(rounded)) < 1e-9 &&
-              static_cast<std::uint64_t>(rounded) == lastStartedAsyncRecordHandle_ &&
-              asyncRecordMatch.captured(1) != lastStartedAsyncRecordCallback_) {
-            engine_.deleteVar(lastStartedAsyncRecordCallback_.toStdString());
-          }
-        }
-      }
-      result.output = QString("audio_record handle %1").arg(lastStartedAsyncRecordHandle_).toStdString();
     }
-    updateCommandPrompt();
-    const QString trimmed = actual.trimmed();
-    const bool suppressEcho = trimmed.endsWith(';');
-    const bool isOk = result.status == static_cast<int>(auxEvalStatus::AUX_EVAL_OK);
-    if (suppressEcho && isOk) {
-      commandBox_->appendExecutionResult({});
-    } else {
-      commandBox_->appendExecutionResult(QString::fromStdString(result.output));
-    }
-    historyNavIndex_ = -1;
-    historyDraft_.clear();
-    reverseSearchActive_ = false;
-    reverseSearchTerm_.clear();
-    reverseSearchIndex_ = -1;
+    result.output = QString("audio_record handle %1").arg(lastStartedAsyncRecordHandle_).toStdString();
+  }
+  updateCommandPrompt();
+  const QString trimmed = actual.trimmed();
+  const bool suppressEcho = trimmed.endsWith(';');
+  const bool isOk = result.status == static_cast<int>(auxEvalStatus::AUX_EVAL_OK);
+  if (suppressEcho && isOk) {
+    echoCommandResult({});
   } else {
-    updateCommandPrompt();
-    commandBox_->appendExecutionResult({});
-    historyNavIndex_ = -1;
-    historyDraft_.clear();
-    reverseSearchActive_ = false;
-    reverseSearchTerm_.clear();
-    reverseSearchIndex_ = -1;
+    echoCommandResult(QString::fromStdString(result.output));
   }
+  historyNavIndex_ = -1;
+  historyDraft_.clear();
+  reverseSearchActive_ = false;
+  reverseSearchTerm_.clear();
+  reverseSearchIndex_ = -1;
+}
 
+void MainWindow::startBackgroundEval(const QString& actual) {
+  if (!evalThread_) {
+    evalThread_ = new QThread(this);
+    // UDF recursion in the engine needs more than the default secondary-thread stack.
+    evalThread_->setStackSize(64u * 1024u * 1024u);
+    evalWorker_ = new QObject;
+    evalWorker_->moveToThread(evalThread_);
+    connect(evalThread_, &QThread::finished, evalWorker_, &QObject::deleteLater);
+    evalThread_->start();
+  }
+
+  evalInFlight_ = true;
+  evalInterruptRequested_.store(false);
+  commandBox_->setBusy(true);
+  statusBar()->showMessage("Evaluating... (Ctrl+C to interrupt)");
+  const std::string command = actual.toStdString();
+  QMetaObject::invokeMethod(evalWorker_, [this, actual, command]() {
+    const EvalResult result = engine_.eval(command);
+    QMetaObject::invokeMethod(this, [this, actual, result]() {
+      onBackgroundEvalFinished(actual, result);
+    }, Qt::QueuedConnection);
+  }, Qt::QueuedConnection);
+}
+
+void MainWindow::onBackgroundEvalFinished(const QString& actual, const EvalResult& result) {
+  evalInFlight_ = false;
+  if (shuttingDown_) {
+    return;
+  }
+  const bool interrupted = evalInterruptRequested_.exchange(false);
+  commandBox_->setBusy(false);
+  statusBar()->clearMessage();
+  finishEvaluatedCommand(actual, result);
+  if (interrupted && result.status != static_cast<int>(auxEvalStatus::AUX_EVAL_OK)) {
+    appendConsoleMessage("Interrupted.");
+  }
+  // Refreshes requested while the command ran returned early; this replays them.
   refreshVariables();
   refreshDebugView();
   reconcileScopedWindows();
+  // Poll ticks and capture-worker notifications skipped while the command ran would
+  // otherwise wait for the next notification; drain once before a queued command
+  // makes the engine busy again.
+  onAsyncPollTick();
+
+  if (closePending_) {
+    pendingCommands_.clear();
+    close();
+    return;
+  }
+  while (!evalInFlight_ && !pendingCommands_.empty()) {
+    const PendingCommand next = pendingCommands_.front();
+    pendingCommands_.pop_front();
+    runCommand(next.text, next.addToHistory);
+  }
+}
+
+void MainWindow::echoCommandResult(const QString& output) {
+  if (backgroundEval_) {
+    // The command line was closed on submit so typing can continue; results
+    // arrive above the live prompt.
+    appendConsoleMessage(output);
+    return;
+  }
+  commandBox_->appendExecutionResult(output);
+}
+
+void MainWindow::interruptEvaluation() {
+  const int dropped = static_cast<int>(pendingCommands_.size());
+  pendingCommands_.clear();
+  if (evalInFlight_) {
+    // The engine has no asynchronous abort; the command is stopped by failing its
+    // next graphics, playback or recording call. Pure computation runs to completion.
+    evalInterruptRequested_.store(true);
+    const QString note = "the command stops at its next graphics or audio call";
+    statusBar()->showMessage(dropped > 0 ? QString("Interrupt requested (%1); %2 queued command(s) dropped.").arg(note).arg(dropped)
+                                         : QString("Interrupt requested (%1).").arg(note),
+                             4000);
+    return;
+  }
+  if (engine_.isPaused()) {
+    handleDebugAction(auxDebugAction::AUX_DEBUG_ABORT_BASE);
+  }
+}
+
+bool MainWindow::engineBusy() const {
+  return evalInFlight_ && backendCallDepth_ == 0;
+}
+
+bool MainWindow::rejectWhileEngineBusy() {
+  if (!engineBusy()) {
+    return false;
+  }
+  statusBar()->showMessage("The engine is busy evaluating a command (Ctrl+C to interrupt).", 2500);
+  return true;
+}
+
+bool MainWindow::backendCallInterrupted(std::string& err) const {
+  if (!evalInterruptRequested_.load()) {
+    return false;
+  }
+  err = "Interrupted by user.";
+  return true;
+}
+
+void MainWindow::setBackendCallActive(bool active) {
+  backendCallDepth_ = std::max(0, backendCallDepth_ + (active ? 1 : -1));
 }
 
 void MainWindow::appendConsoleMessage(const QString& text) {
@@ -2829,7 +3507,7 @@ bool MainWindow::tryHandleGraphicsCommand(const QString& cmd, QString& output) {
       graphicsManager_.markFocused(targetWindow);
     }
     if (!sig->isAudio && !sig->channels.empty()) {
-      const int expectedLength = static_cast<int>(sig->channels.front().samples.size());
+      const int expectedLength = channelLength(sig->channels.front());
       if (const auto xdata = extractRangeXData(expr, expectedLength); xdata.has_value()) {
         targetWindow->applyXDataToAllLines(*xdata);
       }
@@ -3095,6 +3773,9 @@ bool MainWindow::tryHandleGraphicsCommand(const QString& cmd, QString& output) {
 }
 
 void MainWindow::onAsyncPollTick() {
+  if (engineBusy()) {
+    return;
+  }
   refreshPlaybackHandles();
   processRecordingSessions();
   const int changed = engine_.pollAsync();
@@ -3190,85 +3871,21 @@ void MainWindow::processRecordingSessions() {
       anyUpdated = true;
     }
 
-    if (!session.sink || session.captureBytesPerSample <= 0 || session.captureChannels <= 0 || session.sampleRate <= 0) {
-      continue;
-    }
-
-    const QByteArray rawData = session.sink->snapshot();
-    const qsizetype bytesPerFrame = static_cast<qsizetype>(session.captureBytesPerSample) * static_cast<qsizetype>(session.captureChannels);
-    if (bytesPerFrame <= 0) {
+    if (!session.worker || session.sampleRate <= 0) {
       continue;
     }
 
-    const qsizetype completeBytes = rawData.size() - (rawData.size() % bytesPerFrame);
-    if (completeBytes <= session.rawBytesConsumed) {
+    std::string workerErr;
+    if (!session.worker->takeBlocks(session.readyBlocks, workerErr)) {
+      callbackMessages.push_back(QString::fromStdString(workerErr));
+      failedSessions.push_back(session.handleId);
       continue;
     }
-
-    const char* base = rawData.constData() + session.rawBytesConsumed;
-    const qsizetype newFrames = (completeBytes - session.rawBytesConsumed) / bytesPerFrame;
-    session.capturedInterleaved.reserve(session.capturedInterleaved.size() +
-                                        static_cast<size_t>(newFrames) * static_cast<size_t>(session.captureChannels));
-
-    for (qsizetype frame = 0; frame < newFrames; ++frame) {
-      const char* framePtr = base + frame * bytesPerFrame;
-      for (int ch = 0; ch < session.captureChannels; ++ch) {
-        const char* samplePtr = framePtr + ch * session.captureBytesPerSample;
-        session.capturedInterleaved.push_back(
-            decodeAudioSample(static_cast<QAudioFormat::SampleFormat>(session.captureSampleFormat), samplePtr));
-      }
-    }
-    session.rawBytesConsumed = completeBytes;
-
-    const qsizetype captureFrames =
-        static_cast<qsizetype>(session.capturedInterleaved.size() / static_cast<size_t>(session.captureChannels));
-    if (captureFrames <= 1) {
+    const qsizetype framesProduced = session.worker->framesProduced();
+    if (framesProduced == session.outputFramesProduced && session.readyBlocks.empty()) {
       continue;
     }
-
-    auto sourceSampleAt = [&](qsizetype frameIndex, int requestedChannel) -> double {
-      frameIndex = std::clamp<qsizetype>(frameIndex, 0, captureFrames - 1);
-      if (session.captureChannels == 1) {
-        return session.capturedInterleaved[static_cast<size_t>(frameIndex)];
-      }
-      if (session.channelCount == 1) {
-        const size_t baseIndex = static_cast<size_t>(frameIndex) * static_cast<size_t>(session.captureChannels);
-        double sum = 0.0;
-        for (int ch = 0; ch < session.captureChannels; ++ch) {
-          sum += session.capturedInterleaved[baseIndex + static_cast<size_t>(ch)];
-        }
-        return sum / static_cast<double>(session.captureChannels);
-      }
-      const int srcCh = std::min(requestedChannel, session.captureChannels - 1);
-      return session.capturedInterleaved[static_cast<size_t>(frameIndex) * static_cast<size_t>(session.captureChannels) +
-                                         static_cast<size_t>(srcCh)];
-    };
-
-    const double ratio = static_cast<double>(session.captureSampleRate) / static_cast<double>(session.sampleRate);
-    while (true) {
-      const double srcPos = static_cast<double>(session.outputFramesProduced) * ratio;
-      const qsizetype srcIndex0 = static_cast<qsizetype>(std::floor(srcPos));
-      const qsizetype srcIndex1 = srcIndex0 + 1;
-      if (srcIndex1 >= captureFrames) {
-        break;
-      }
-      const double frac = srcPos - static_cast<double>(srcIndex0);
-      for (int outCh = 0; outCh < session.channelCount; ++outCh) {
-        const double s0 = sourceSampleAt(srcIndex0, outCh);
-        const double s1 = sourceSampleAt(srcIndex1, outCh);
-        session.pendingConvertedInterleaved.push_back(std::clamp(s0 + (s1 - s0) * frac, -1.0, 1.0));
-      }
-      ++session.outputFramesProduced;
-    }
-
-    const qsizetype blockFrames =
-        std::max<qsizetype>(1, static_cast<qsizetype>(std::llround(session.blockMs * static_cast<double>(session.sampleRate) / 1000.0)));
-    const qsizetype blockSamples = blockFrames * static_cast<qsizetype>(session.channelCount);
-    while (static_cast<qsizetype>(session.pendingConvertedInterleaved.size()) >= blockSamples) {
-      auto endIt = session.pendingConvertedInterleaved.begin() + blockSamples;
-      session.readyBlocks.emplace_back(session.pendingConvertedInterleaved.begin(), endIt);
-      session.pendingConvertedInterleaved.erase(session.pendingConvertedInterleaved.begin(), endIt);
-    }
+    session.outputFramesProduced = framesProduced;
 
     const double durRecMs = 1000.0 * static_cast<double>(session.outputFramesProduced) / static_cast<double>(session.sampleRate);
     std::map<std::string, double> members;
@@ -3280,6 +3897,7 @@ void MainWindow::processRecordingSessions() {
       members["durLeft"] = 0.0;
       members["prog"] = 0.0;
     }
+    noteDroppedCaptureFrames(session, members, callbackMessages);
     engine_.updateRuntimeHandleMembers(session.handleId, members);
     anyUpdated = true;
 
@@ -3289,10 +3907,12 @@ void MainWindow::processRecordingSessions() {
       payload.num_channels = session.channelCount;
       payload.callback_index = session.callbackIndex + 1;
       payload.interleaved = std::move(session.readyBlocks.front());
-      session.readyBlocks.erase(session.readyBlocks.begin());
+      session.readyBlocks.pop_front();
 
       std::string output;
-      if (!engine_.invokeRecordCallback(session.handleId, session.callbackName.toStdString(), payload, output)) {
+      const bool ok = engine_.invokeRecordCallback(session.handleId, session.callbackName.toStdString(), payload, output);
+      session.worker->recycleBlock(std::move(payload.interleaved));
+      if (!ok) {
         QString msg = QString("Error in recording callback %1: %2")
                           .arg(session.callbackName, QString::fromStdString(output).trimmed());
         callbackMessages.push_back(msg);
@@ -3326,6 +3946,22 @@ void MainWindow::processRecordingSessions() {
   suppressWindowActivation_ = previousSuppressWindowActivation;
 }
 
+void MainWindow::noteDroppedCaptureFrames(RecordingSession& session,
+                                          std::map<std::string, double>& members,
+                                          QStringList& messages) {
+  if (!session.sink || session.captureSampleRate <= 0) {
+    return;
+  }
+  const quint64 dropped = session.sink->droppedFrames();
+  members["durDropped"] = 1000.0 * static_cast<double>(dropped) / static_cast<double>(session.captureSampleRate);
+  if (dropped > 0 && !session.droppedWarned) {
+    session.droppedWarned = true;
+    messages.push_back(QString("Warning: recording handle %1 is losing input; the capture buffer overflowed "
+                               "and audio was dropped (see .durDropped).")
+                           .arg(static_cast<qulonglong>(session.handleId)));
+  }
+}
+
 void MainWindow::updateCommandPrompt() {
   if (!commandBox_) {
     return;
@@ -3381,6 +4017,9 @@ QStringList MainWindow::selectedVarNames(QTreeWidget* box) const {
 }
 
 void MainWindow::deleteVariablesFromBox(QTreeWidget* box) {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   const QStringList names = selectedVarNames(box);
   if (names.isEmpty()) {
     return;
@@ -3404,6 +4043,9 @@ void MainWindow::deleteVariablesFromBox(QTreeWidget* box) {
 }
 
 void MainWindow::showVariableContextMenu(QTreeWidget* box, const QPoint& pos) {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   if (!box) {
     return;
   }
@@ -3425,6 +4067,9 @@ void MainWindow::showVariableContextMenu(QTreeWidget* box, const QPoint& pos) {
 }
 
 void MainWindow::refreshVariables() {
+  if (engineBusy()) {
+    return;
+  }
   const QString selected = selectedVarName();
   audioVariableBox_->clear();
   nonAudioVariableBox_->clear();
@@ -3455,6 +4100,9 @@ void MainWindow::refreshVariables() {
 }
 
 void MainWindow::refreshDebugView() {
+  if (engineBusy()) {
+    return;
+  }
   const bool paused = engine_.isPaused();
   updateCommandPrompt();
   debugWindow_->setPaused(paused);
@@ -3845,6 +4493,9 @@ void MainWindow::openSignalGraphForSelected() {
 }
 
 void MainWindow::focusSignalGraphForSelected() {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   const QString var = selectedVarName();
   if (var.isEmpty()) {
     return;
@@ -3861,6 +4512,9 @@ void MainWindow::focusSignalGraphForSelected() {
 }
 
 void MainWindow::openSignalTableForSelected() {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   const QString var = selectedVarName();
   openPathDetail(var);
 }
@@ -3871,17 +4525,33 @@ void MainWindow::playSelectedAudioFromVarBox() {
 }
 
 void MainWindow::openSignalGraphForPath(const QString& path) {
-  if (path.isEmpty() || !variableSupportsSignalDisplay(path)) {
+  if (rejectWhileEngineBusy()) {
     return;
   }
-  auto sig = engine_.getSignalData(path.toStdString());
-  if (!sig) {
+  if (path.isEmpty()) {
+    return;
+  }
+  // One pass over the engine's view: long audio keeps only its shape (the graph pages
+  // samples in), anything else is copied once straight from the engine buffers.
+  std::optional<SignalInfo> info;
+  std::optional<SignalData> sig;
+  bool paged = false;
+  engine_.withSignalView(path.toStdString(), [&](const SignalView& view) {
+    paged = view.isAudio && view.totalSamples >= kPagedGraphMinSamples;
+    info = signalViewInfo(view);
+    sig = paged ? signalOutline(*info) : materializeSignalView(view);
+  });
+  if (!info || !sig) {
     return;
   }
 
   const auto currentScope = engine_.activeContext();
   if (auto* existing = findSignalGraphWindow(path, currentScope)) {
-    existing->updateData(*sig);
+    if (paged) {
+      attachPagedSource(existing, path, *info);
+    } else {
+      existing->updateData(*sig);
+    }
     focusWindow(existing);
     graphicsManager_.markFocused(existing);
     return;
@@ -3894,8 +4564,17 @@ void MainWindow::openSignalGraphForPath(const QString& path) {
 
   auto* w = new SignalGraphWindow(
       path, *sig, options, nullptr,
-      [this, path](int viewStart, int viewLen) { return engine_.getSignalFftPowerDb(path.toStdString(), viewStart, viewLen); });
+      [this, path](int viewStart, int viewLen) {
+        if (engineBusy()) {
+          return std::vector<std::vector<double>>{};
+        }
+        return signalSpectrumDb(path, viewStart, viewLen);
+      });
+  if (paged) {
+    attachPagedSource(w, path, *info);
+  }
   w->setAttribute(Qt::WA_DeleteOnClose, true);
+  w->setSpectrumOptions(spectrumOptions());
   trackWindow(path, w, WindowKind::Graph);
   focusWindow(w);
   graphicsManager_.markFocused(w);
@@ -3909,6 +4588,7 @@ SignalGraphWindow* MainWindow::createEmptyFigureWindow(const QString& title, con
 
   auto* w = new SignalGraphWindow(title, emptyData, options);
   w->setAttribute(Qt::WA_DeleteOnClose, true);
+  w->setSpectrumOptions(spectrumOptions());
   if (geometry.isValid()) {
     w->setGeometry(geometry);
   }
@@ -3918,6 +4598,34 @@ SignalGraphWindow* MainWindow::createEmptyFigureWindow(const QString& title, con
   return w;
 }
 
+void MainWindow::attachPagedSource(SignalGraphWindow* window, const QString& path, const SignalInfo& info) {
+  window->setPagedSource(info, [this, path](int channel, int startSample, int length, int blockSize) {
+    if (engineBusy()) {
+      return std::vector<double>{};
+    }
+    const auto samples = blockSize <= 1
+                             ? engine_.getSignalWindow(path.toStdString(), channel, startSample, length)
+                             : engine_.getSignalEnvelope(path.toStdString(), channel, startSample, length, blockSize);
+    return samples.value_or(std::vector<double>{});
+  });
+}
+
+std::vector<std::vector<double>> MainWindow::signalSpectrumDb(const QString& path, int viewStart, int viewLen) const {
+  if (welchSpectrum_) {
+    return engine_.getSignalWelchPowerDb(path.toStdString(), viewStart, viewLen, welchOptions_);
+  }
+  return engine_.getSignalFftPowerDb(path.toStdString(), viewStart, viewLen);
+}
+
+WelchOptions MainWindow::spectrumOptions() const {
+  if (welchSpectrum_) {
+    return welchOptions_;
+  }
+  WelchOptions single = welchOptions_;
+  single.segmentSize = 1 << kMaxSingleFftLog2;
+  return single;
+}
+
 SignalGraphWindow* MainWindow::createSignalFigureWindow(const QString& title,
                                                        const SignalData& data,
                                                        bool namedPlot,
@@ -3935,10 +4643,14 @@ SignalGraphWindow* MainWindow::createSignalFigureWindow(const QString& title,
       options,
       nullptr,
       [this, sourcePath, variableBacked, trackName](int viewStart, int viewLen) {
+        if (engineBusy()) {
+          return std::vector<std::vector<double>>{};
+        }
         const QString fftSource = variableBacked && !sourcePath.isEmpty() ? sourcePath : trackName;
-        return engine_.getSignalFftPowerDb(fftSource.toStdString(), viewStart, viewLen);
+        return signalSpectrumDb(fftSource, viewStart, viewLen);
       });
   w->setAttribute(Qt::WA_DeleteOnClose, true);
+  w->setSpectrumOptions(spectrumOptions());
   trackWindow(trackName, w, WindowKind::Graph, variableBacked);
   focusWindow(w);
   graphicsManager_.markFocused(w);
@@ -3946,6 +4658,9 @@ SignalGraphWindow* MainWindow::createSignalFigureWindow(const QString& title,
 }
 
 void MainWindow::openPathDetail(const QString& path) {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   if (path.isEmpty()) {
     return;
   }
@@ -4074,12 +4789,10 @@ bool MainWindow::openGraphicsPathDetail(const QString& path) {
 }
 
 void MainWindow::playAudioForPath(const QString& path) {
-  if (path.isEmpty() || !variableIsAudio(path)) {
+  if (rejectWhileEngineBusy()) {
     return;
   }
-
-  auto sig = engine_.getSignalData(path.toStdString());
-  if (!sig || !sig->isAudio || sig->channels.empty()) {
+  if (path.isEmpty() || !variableIsAudio(path)) {
     return;
   }
 
@@ -4103,11 +4816,23 @@ void MainWindow::playAudioForPath(const QString& path) {
     varAudioBuffer_ = nullptr;
   }
 
-  QAudioFormat fmt;
-  const int sampleRate = sig->sampleRate > 0 ? sig->sampleRate : 22050;
+  int sampleRate = 22050;
   int chCount = 0;
   int totalFrames = 0;
-  varPcmData_ = buildAudioPcm16(*sig, chCount, totalFrames);
+  bool isAudio = false;
+  const bool viewed = engine_.withSignalView(path.toStdString(), [&](const SignalView& sig) {
+    isAudio = sig.isAudio && !sig.channels.empty();
+    if (!isAudio) {
+      return;
+    }
+    sampleRate = sig.sampleRate > 0 ? sig.sampleRate : 22050;
+    varPcmData_ = buildAudioPcm16(sig, chCount, totalFrames);
+  });
+  if (!viewed || !isAudio) {
+    return;
+  }
+
+  QAudioFormat fmt;
   fmt.setSampleRate(sampleRate);
   fmt.setChannelCount(chCount);
   fmt.setSampleFormat(QAudioFormat::Int16);
@@ -4130,7 +4855,7 @@ bool MainWindow::startPlaybackHandle(std::uint64_t handleId,
     return false;
   }
 
-  const auto sig = buildSignalDataFromAuxObj(obj, 22050);
+  const auto sig = buildSignalViewFromAuxObj(obj, 22050);
   if (!sig || !sig->isAudio || sig->channels.empty()) {
     err = "play() requires an audio object.";
     return false;
@@ -4152,9 +4877,7 @@ bool MainWindow::startPlaybackHandle(std::uint64_t handleId,
 
   const int sampleRate = sig->sampleRate > 0 ? sig->sampleRate : 22050;
   const double onePassDurationMs = sig->startTimeSec * 1000.0 +
-                                   (sig->channels.empty() ? 0.0
-                                                          : 1000.0 * static_cast<double>(sig->channels.front().samples.size()) /
-                                                                static_cast<double>(sampleRate));
+                                   1000.0 * static_cast<double>(sig->totalSamples) / static_cast<double>(sampleRate);
   int channelCount = 0;
   int onePassFrames = 0;
   QByteArray onePassPcm = buildAudioPcm16(*sig, channelCount, onePassFrames);
@@ -4163,11 +4886,6 @@ bool MainWindow::startPlaybackHandle(std::uint64_t handleId,
     return false;
   }
 
-  QByteArray repeatedPcm;
-  repeatedPcm.reserve(onePassPcm.size() * repeatCount);
-  for (int i = 0; i < repeatCount; ++i) {
-    repeatedPcm += onePassPcm;
-  }
   auto it = playbackSessions_.find(handleId);
   if (reuseExistingHandle) {
     if (it == playbackSessions_.end()) {
@@ -4175,26 +4893,18 @@ bool MainWindow::startPlaybackHandle(std::uint64_t handleId,
       return false;
     }
     PlaybackSession& session = it->second;
-    if ((!session.paused && (!session.sink || !session.buffer ||
+    if ((!session.paused && (!session.sink || !session.source ||
          session.sink->state() == QAudio::IdleState || session.sink->state() == QAudio::StoppedState)) ||
         session.sampleRate != sampleRate || session.channelCount != channelCount) {
       err = "Queued playback must match the active playback format.";
       return false;
     }
-    session.pcmData += repeatedPcm;
-    if (session.buffer) {
-      session.buffer->buffer().append(repeatedPcm);
-    }
-    int cumulativeEnd = session.segmentEndFrames.empty() ? 0 : session.segmentEndFrames.back();
-    for (int i = 0; i < repeatCount; ++i) {
-      cumulativeEnd += onePassFrames;
-      session.segmentEndFrames.push_back(cumulativeEnd);
-    }
+    session.source->append(onePassPcm, repeatCount);
     session.totalFrames += onePassFrames * repeatCount;
     session.durationMs += onePassDurationMs * repeatCount;
     engine_.updateRuntimeHandleMembers(handleId,
                                        {{"dur", session.durationMs},
-                                        {"repeat_left", static_cast<double>(std::max(0, static_cast<int>(session.segmentEndFrames.size()) - 1))}});
+                                        {"repeat_left", static_cast<double>(std::max(0, session.source->totalPasses() - 1))}});
     refreshVariables();
     return true;
   }
@@ -4202,8 +4912,8 @@ bool MainWindow::startPlaybackHandle(std::uint64_t handleId,
   for (auto& entry : playbackSessions_) {
     PlaybackSession& existing = entry.second;
     engine_.updateRuntimeHandleMembers(existing.handleId, {{"repeat_left", 0.0}, {"prog", 100.0}});
-    if (existing.buffer) {
-      existing.buffer->close();
+    if (existing.source) {
+      existing.source->close();
     }
     if (existing.sink) {
       existing.sink->disconnect(this);
@@ -4212,9 +4922,9 @@ bool MainWindow::startPlaybackHandle(std::uint64_t handleId,
       existing.sink->deleteLater();
       existing.sink = nullptr;
     }
-    if (existing.buffer) {
-      existing.buffer->deleteLater();
-      existing.buffer = nullptr;
+    if (existing.source) {
+      existing.source->deleteLater();
+      existing.source = nullptr;
     }
   }
   playbackSessions_.clear();
@@ -4226,33 +4936,27 @@ bool MainWindow::startPlaybackHandle(std::uint64_t handleId,
   session.repeatCount = repeatCount;
   session.durationMs = onePassDurationMs * repeatCount;
   session.totalFrames = onePassFrames * repeatCount;
-  session.pcmData = std::move(repeatedPcm);
-  int cumulativeEnd = 0;
-  for (int i = 0; i < repeatCount; ++i) {
-    cumulativeEnd += onePassFrames;
-    session.segmentEndFrames.push_back(cumulativeEnd);
-  }
 
   QAudioFormat fmt;
   fmt.setSampleRate(session.sampleRate);
   fmt.setChannelCount(session.channelCount);
   fmt.setSampleFormat(QAudioFormat::Int16);
 
-  session.buffer = new QBuffer(this);
-  session.buffer->setData(session.pcmData);
-  session.buffer->open(QIODevice::ReadOnly);
+  session.source = new LoopingPcmSource(this);
+  session.source->append(onePassPcm, repeatCount);
+  session.source->open(QIODevice::ReadOnly);
 
   session.sink = new QAudioSink(fmt, this);
   connect(session.sink, &QAudioSink::stateChanged, this, [this](QAudio::State) {
     refreshPlaybackHandles();
   });
-  session.sink->start(session.buffer);
+  session.sink->start(session.source);
 
   playbackSessions_[handleId] = std::move(session);
   engine_.updateRuntimeHandleMembers(handleId,
                                      {{"fs", static_cast<double>(playbackSessions_[handleId].sampleRate)},
                                       {"dur", playbackSessions_[handleId].durationMs},
-                                      {"repeat_left", static_cast<double>(std::max(0, static_cast<int>(playbackSessions_[handleId].segmentEndFrames.size()) - 1))},
+                                      {"repeat_left", static_cast<double>(std::max(0, repeatCount - 1))},
                                       {"prog", 0.0}});
   refreshVariables();
   return true;
@@ -4290,13 +4994,11 @@ bool MainWindow::controlPlaybackHandle(std::uint64_t handleId,
 
         for (auto& entry : playbackSessions_) {
           PlaybackSession& other = entry.second;
-          if (other.sink && other.buffer) {
-            const qint64 bytesConsumed =
-                other.pcmData.size() - std::max<qint64>(0, other.buffer->bytesAvailable());
-            other.pausedBytes = std::clamp<qint64>(bytesConsumed, 0, other.pcmData.size());
+          if (other.sink && other.source) {
+            other.pausedBytes = std::clamp<qint64>(other.source->pos(), 0, other.source->size());
           }
-          if (other.buffer) {
-            other.buffer->close();
+          if (other.source) {
+            other.source->close();
           }
           if (other.sink) {
             other.sink->disconnect(this);
@@ -4305,10 +5007,6 @@ bool MainWindow::controlPlaybackHandle(std::uint64_t handleId,
             delete other.sink;
             other.sink = nullptr;
           }
-          if (other.buffer) {
-            delete other.buffer;
-            other.buffer = nullptr;
-          }
           other.paused = true;
         }
         refreshVariables();
@@ -4318,7 +5016,7 @@ bool MainWindow::controlPlaybackHandle(std::uint64_t handleId,
         if (!session.paused) {
           return true;
         }
-        if (session.pausedBytes >= session.pcmData.size()) {
+        if (!session.source || session.pausedBytes >= session.source->size()) {
           err = "Invalid or inactive playback handle.";
           return false;
         }
@@ -4326,15 +5024,13 @@ bool MainWindow::controlPlaybackHandle(std::uint64_t handleId,
         fmt.setSampleRate(session.sampleRate);
         fmt.setChannelCount(session.channelCount);
         fmt.setSampleFormat(QAudioFormat::Int16);
-        session.buffer = new QBuffer(this);
-        session.buffer->setData(session.pcmData);
-        session.buffer->open(QIODevice::ReadOnly);
-        session.buffer->seek(session.pausedBytes);
+        session.source->open(QIODevice::ReadOnly);
+        session.source->seek(session.pausedBytes);
         session.sink = new QAudioSink(fmt, this);
         connect(session.sink, &QAudioSink::stateChanged, this, [this](QAudio::State) {
           refreshPlaybackHandles();
         });
-        session.sink->start(session.buffer);
+        session.sink->start(session.source);
         session.paused = false;
         refreshVariables();
         return true;
@@ -4362,8 +5058,8 @@ bool MainWindow::controlPlaybackHandle(std::uint64_t handleId,
   for (auto& entry : playbackSessions_) {
     PlaybackSession& session = entry.second;
     engine_.updateRuntimeHandleMembers(session.handleId, {{"repeat_left", 0.0}, {"prog", 100.0}});
-    if (session.buffer) {
-      session.buffer->close();
+    if (session.source) {
+      session.source->close();
     }
     if (session.sink) {
       session.sink->disconnect(this);
@@ -4372,11 +5068,10 @@ bool MainWindow::controlPlaybackHandle(std::uint64_t handleId,
       delete session.sink;
       session.sink = nullptr;
     }
-    if (session.buffer) {
-      delete session.buffer;
-      session.buffer = nullptr;
+    if (session.source) {
+      delete session.source;
+      session.source = nullptr;
     }
-    session.pcmData.clear();
   }
   playbackSessions_.clear();
   refreshVariables();
@@ -4460,7 +5155,10 @@ bool MainWindow::recordAudio(int deviceId,
   }
 
   QAudioSource source(selected, fmt);
-  AudioCaptureSink sink;
+  // Nothing drains the ring until capture ends, so size it for the whole request.
+  AudioCaptureSink sink(static_cast<qsizetype>(std::llround((durationMs + 1000.0) * fmt.sampleRate() / 1000.0)) *
+                            bytesPerSample * captureChannels,
+                        bytesPerSample * captureChannels);
   sink.open(QIODevice::WriteOnly);
   std::string runtimeErr;
   QEventLoop loop;
@@ -4506,7 +5204,12 @@ bool MainWindow::recordAudio(int deviceId,
     return false;
   }
 
-  const QByteArray rawData = sink.snapshot();
+  QByteArray rawData;
+  sink.drain(rawData);
+  if (sink.droppedFrames() > 0) {
+    appendConsoleMessage(QString("Warning: record() dropped %1 input frame(s); the capture buffer overflowed.")
+                             .arg(static_cast<qulonglong>(sink.droppedFrames())));
+  }
 
   const int bytesPerFrame = bytesPerSample * captureChannels;
   if (bytesPerFrame <= 0 || rawData.size() < bytesPerFrame) {
@@ -4531,50 +5234,23 @@ bool MainWindow::recordAudio(int deviceId,
       static_cast<qsizetype>(std::llround(durationMs * static_cast<double>(sampleRate) / 1000.0)));
   result.sample_rate = sampleRate;
   result.num_channels = channelCount;
-  result.interleaved.reserve(static_cast<size_t>(targetFrames) * static_cast<size_t>(channelCount));
 
-  std::vector<double> capturedInterleaved;
-  capturedInterleaved.reserve(static_cast<size_t>(captureFrames) * static_cast<size_t>(captureChannels));
+  std::vector<float> decoded;
+  std::vector<float> captured;
+  decodeCaptureFrames(fmt.sampleFormat(), rawData.constData(), captureFrames, captureChannels, channelCount, decoded, captured);
 
-  const char* base = rawData.constData();
-  for (qsizetype frame = 0; frame < captureFrames; ++frame) {
-    const char* framePtr = base + frame * bytesPerFrame;
-    for (int ch = 0; ch < captureChannels; ++ch) {
-      const char* samplePtr = framePtr + ch * bytesPerSample;
-      capturedInterleaved.push_back(decodeAudioSample(fmt.sampleFormat(), samplePtr));
-    }
+  StreamResampler resampler;
+  std::vector<float> converted;
+  if (!resampler.init(channelCount, fmt.sampleRate(), sampleRate, recordResampleQuality_, err) ||
+      !resampler.process(captured.data(), static_cast<long>(captureFrames), converted, err) ||
+      !resampler.finish(converted, err)) {
+    return false;
   }
 
-  auto sourceSampleAt = [&](qsizetype frameIndex, int requestedChannel) -> double {
-    frameIndex = std::clamp<qsizetype>(frameIndex, 0, captureFrames - 1);
-    if (captureChannels == 1) {
-      return capturedInterleaved[static_cast<size_t>(frameIndex)];
-    }
-    if (channelCount == 1) {
-      const size_t baseIndex = static_cast<size_t>(frameIndex) * static_cast<size_t>(captureChannels);
-      double sum = 0.0;
-      for (int ch = 0; ch < captureChannels; ++ch) {
-        sum += capturedInterleaved[baseIndex + static_cast<size_t>(ch)];
-      }
-      return sum / static_cast<double>(captureChannels);
-    }
-    const int srcCh = std::min(requestedChannel, captureChannels - 1);
-    return capturedInterleaved[static_cast<size_t>(frameIndex) * static_cast<size_t>(captureChannels) +
-                               static_cast<size_t>(srcCh)];
-  };
-
-  const double ratio = static_cast<double>(fmt.sampleRate()) / static_cast<double>(sampleRate);
-  for (qsizetype outFrame = 0; outFrame < targetFrames; ++outFrame) {
-    const double srcPos = static_cast<double>(outFrame) * ratio;
-    const qsizetype srcIndex0 = static_cast<qsizetype>(std::floor(srcPos));
-    const qsizetype srcIndex1 = std::min(captureFrames - 1, srcIndex0 + 1);
-    const double frac = srcPos - static_cast<double>(srcIndex0);
-    for (int outCh = 0; outCh < channelCount; ++outCh) {
-      const double s0 = sourceSampleAt(srcIndex0, outCh);
-      const double s1 = sourceSampleAt(srcIndex1, outCh);
-      result.interleaved.push_back(std::clamp(s0 + (s1 - s0) * frac, -1.0, 1.0));
-    }
-  }
+  // The converter's length can differ from the request by a few frames; pad or trim.
+  converted.resize(static_cast<size_t>(targetFrames) * static_cast<size_t>(channelCount), 0.0f);
+  result.interleaved.resize(converted.size());
+  decodePcm(PcmFormat::Float, converted.data(), converted.size(), result.interleaved.data());
 
   return !result.interleaved.empty();
 }
@@ -4697,11 +5373,37 @@ bool MainWindow::startAsyncRecordHandle(std::uint64_t handleId,
       spec.duration_ms > 0.0 ? std::max(1, static_cast<int>(std::llround(spec.duration_ms))) : -1;
   session.active = true;
   session.paused = false;
+  auto resampler = std::make_unique<StreamResampler>();
+  if (!resampler->init(session.channelCount, session.captureSampleRate, session.sampleRate, recordResampleQuality_, err)) {
+    return false;
+  }
   session.source = new QAudioSource(selected, fmt, this);
-  auto* sink = new AudioCaptureSink(this);
+  const int captureFrameBytes = session.captureBytesPerSample * session.captureChannels;
+  auto* sink = new AudioCaptureSink(
+      static_cast<qsizetype>(std::llround(static_cast<double>(kCaptureRingMs) * session.captureSampleRate / 1000.0)) *
+          captureFrameBytes,
+      captureFrameBytes,
+      this);
   sink->open(QIODevice::WriteOnly);
   session.sink = sink;
 
+  CaptureWorker::Format workerFormat;
+  workerFormat.sampleFormat = fmt.sampleFormat();
+  workerFormat.bytesPerSample = session.captureBytesPerSample;
+  workerFormat.captureChannels = session.captureChannels;
+  workerFormat.channelCount = session.channelCount;
+  workerFormat.blockFrames =
+      std::max<qsizetype>(1, static_cast<qsizetype>(std::llround(session.blockMs * static_cast<double>(session.sampleRate) / 1000.0)));
+  // Wake a few times per block so blocks leave the worker close to when they fill.
+  const int wakeMs = std::clamp(static_cast<int>(session.blockMs / 4.0), kMinCaptureWakeMs, kMaxCaptureWakeMs);
+  session.worker = std::make_unique<CaptureWorker>(sink, workerFormat, std::move(resampler), wakeMs, [this]() {
+    QMetaObject::invokeMethod(this, [this]() {
+      if (!engineBusy()) {
+        processRecordingSessions();
+      }
+    }, Qt::QueuedConnection);
+  });
+
   if (spec.duration_ms > 0.0) {
     auto* stopTimer = new QTimer(this);
     stopTimer->setSingleShot(true);
@@ -4710,16 +5412,21 @@ bool MainWindow::startAsyncRecordHandle(std::uint64_t handleId,
       if (it != recordingSessions_.end()) {
         it->second.stopDueToTimeout = true;
       }
-      std::string ignored;
-      controlAsyncRecordHandle(handleId, auxRecordCommand::AUX_RECORD_STOP, ignored);
+      // No AUX caller is waiting on a timed stop, so its errors go to the console.
+      std::string stopErr;
+      if (!controlAsyncRecordHandle(handleId, auxRecordCommand::AUX_RECORD_STOP, stopErr) && !stopErr.empty()) {
+        appendConsoleMessage(QString::fromStdString(stopErr).trimmed());
+      }
     });
     stopTimer->start(session.remainingDurationMs);
     session.stopTimer = stopTimer;
   }
 
   session.source->start(session.sink);
+  session.worker->start();
   if (session.source->state() == QAudio::StoppedState && session.source->error() != QAudio::NoError) {
     err = "Failed to start async audio capture.";
+    session.worker.reset();
     if (session.stopTimer) {
       session.stopTimer->stop();
       session.stopTimer->deleteLater();
@@ -4729,9 +5436,9 @@ bool MainWindow::startAsyncRecordHandle(std::uint64_t handleId,
     return false;
   }
 
-  recordingSessions_[handleId] = session;
   lastStartedAsyncRecordHandle_ = handleId;
   lastStartedAsyncRecordCallback_ = session.callbackName;
+  recordingSessions_[handleId] = std::move(session);
   engine_.updateRuntimeHandleMembers(handleId,
                                      {{"fs", static_cast<double>(spec.sample_rate)},
                                       {"channels", static_cast<double>(spec.num_channels)},
@@ -4740,6 +5447,7 @@ bool MainWindow::startAsyncRecordHandle(std::uint64_t handleId,
                                       {"durRec", 0.0},
                                       {"durLeft", spec.duration_ms > 0.0 ? spec.duration_ms : 0.0},
                                       {"prog", 0.0},
+                                      {"durDropped", 0.0},
                                       {"active", 1.0},
                                       {"paused", 0.0}});
   refreshVariables();
@@ -4760,6 +5468,7 @@ bool MainWindow::controlAsyncRecordHandle(std::uint64_t handleId,
     case auxRecordCommand::AUX_RECORD_STOP: {
       const bool stopDueToTimeout = session.stopDueToTimeout;
       session.stopDueToTimeout = false;
+      bool stopOk = true;
       processRecordingSessions();
       if (session.stopTimer) {
         session.stopTimer->stop();
@@ -4769,7 +5478,17 @@ bool MainWindow::controlAsyncRecordHandle(std::uint64_t handleId,
       if (session.source) {
         session.source->stop();
       }
-      processRecordingSessions();
+      std::vector<double> remainder;
+      if (session.worker) {
+        session.worker->finish(remainder);
+        std::string workerErr;
+        if (!session.worker->takeBlocks(session.readyBlocks, workerErr)) {
+          err = workerErr;
+          stopOk = false;
+        }
+        session.outputFramesProduced = session.worker->framesProduced();
+        session.worker.reset();
+      }
 
       if (stopDueToTimeout && session.durationMs > 0.0 && session.sampleRate > 0 && session.channelCount > 0) {
         const qsizetype targetFrames = std::max<qsizetype>(
@@ -4777,16 +5496,13 @@ bool MainWindow::controlAsyncRecordHandle(std::uint64_t handleId,
         if (session.outputFramesProduced < targetFrames) {
           const qsizetype missingFrames = targetFrames - session.outputFramesProduced;
           const qsizetype missingSamples = missingFrames * static_cast<qsizetype>(session.channelCount);
-          session.pendingConvertedInterleaved.insert(session.pendingConvertedInterleaved.end(),
-                                                     static_cast<size_t>(missingSamples),
-                                                     0.0);
+          remainder.insert(remainder.end(), static_cast<size_t>(missingSamples), 0.0);
           session.outputFramesProduced = targetFrames;
         }
       }
 
-      if (!session.pendingConvertedInterleaved.empty()) {
-        session.readyBlocks.push_back(session.pendingConvertedInterleaved);
-        session.pendingConvertedInterleaved.clear();
+      if (!remainder.empty()) {
+        session.readyBlocks.push_back(std::move(remainder));
       }
 
       const bool previousSuppressWindowActivation = suppressWindowActivation_;
@@ -4797,11 +5513,14 @@ bool MainWindow::controlAsyncRecordHandle(std::uint64_t handleId,
         payload.num_channels = session.channelCount;
         payload.callback_index = session.callbackIndex + 1;
         payload.interleaved = std::move(session.readyBlocks.front());
-        session.readyBlocks.erase(session.readyBlocks.begin());
+        session.readyBlocks.pop_front();
 
         std::string output;
         if (!engine_.invokeRecordCallback(session.handleId, session.callbackName.toStdString(), payload, output)) {
-          err = output.empty() ? "Error in recording callback during final flush." : output;
+          if (stopOk) {
+            err = output.empty() ? "Error in recording callback during final flush." : output;
+          }
+          stopOk = false;
           break;
         }
         engine_.attachRecordCallbackOutputsToHandle(session.handleId, session.handleId);
@@ -4813,6 +5532,12 @@ bool MainWindow::controlAsyncRecordHandle(std::uint64_t handleId,
       }
       suppressWindowActivation_ = previousSuppressWindowActivation;
 
+      std::map<std::string, double> members{{"active", 0.0}, {"paused", 0.0}};
+      QStringList dropMessages;
+      noteDroppedCaptureFrames(session, members, dropMessages);
+      for (const QString& msg : dropMessages) {
+        appendConsoleMessage(msg);
+      }
       if (session.source) {
         session.source->deleteLater();
         session.source = nullptr;
@@ -4824,7 +5549,6 @@ bool MainWindow::controlAsyncRecordHandle(std::uint64_t handleId,
       }
       const double durRecMs =
           1000.0 * static_cast<double>(session.outputFramesProduced) / static_cast<double>(std::max(1, session.sampleRate));
-      std::map<std::string, double> members{{"active", 0.0}, {"paused", 0.0}};
       if (session.durationMs > 0.0) {
         if (stopDueToTimeout) {
           members["durRec"] = session.durationMs;
@@ -4843,7 +5567,9 @@ bool MainWindow::controlAsyncRecordHandle(std::uint64_t handleId,
       engine_.updateRuntimeHandleMembers(handleId, members);
       recordingSessions_.erase(it);
       refreshVariables();
-      return true;
+      // The session is torn down either way; a conversion or final-callback failure
+      // still fails the stop so the caller sees `err`.
+      return stopOk;
     }
     case auxRecordCommand::AUX_RECORD_PAUSE: {
       if (!session.source) {
@@ -4899,18 +5625,13 @@ void MainWindow::refreshPlaybackHandles() {
     }
 
     const qsizetype bytesPerFrame = session.channelCount * static_cast<int>(sizeof(qint16));
-    const qint64 bytesConsumed = session.buffer
-        ? (session.pcmData.size() - std::max<qint64>(0, session.buffer->bytesAvailable()))
-        : 0;
+    const qint64 bytesConsumed = session.source ? std::clamp<qint64>(session.source->pos(), 0, session.source->size()) : 0;
     const int framesConsumed = bytesPerFrame > 0
         ? static_cast<int>(std::clamp<qint64>(bytesConsumed / bytesPerFrame, 0, session.totalFrames))
         : 0;
-    int completedSegments = 0;
-    while (completedSegments < static_cast<int>(session.segmentEndFrames.size()) &&
-           framesConsumed >= session.segmentEndFrames[static_cast<size_t>(completedSegments)]) {
-      ++completedSegments;
-    }
-    const int repeatLeft = std::max(0, static_cast<int>(session.segmentEndFrames.size()) - completedSegments - 1);
+    const int totalPasses = session.source ? session.source->totalPasses() : 0;
+    const int completedPasses = session.source ? session.source->passesCompletedAt(bytesConsumed) : 0;
+    const int repeatLeft = std::max(0, totalPasses - completedPasses - 1);
     const double prog = session.totalFrames > 0
         ? 100.0 * static_cast<double>(framesConsumed) / static_cast<double>(session.totalFrames)
         : 100.0;
@@ -4921,19 +5642,19 @@ void MainWindow::refreshPlaybackHandles() {
 
     if (session.sink->state() == QAudio::IdleState || session.sink->state() == QAudio::StoppedState) {
       QAudioSink* finishedSink = session.sink;
-      QBuffer* finishedBuffer = session.buffer;
+      LoopingPcmSource* finishedSource = session.source;
       engine_.updateRuntimeHandleMembers(session.handleId, {{"repeat_left", 0.0}, {"prog", 100.0}});
       session.sink = nullptr;
-      session.buffer = nullptr;
+      session.source = nullptr;
       anyFinished = true;
       it = playbackSessions_.erase(it);
       if (finishedSink) {
         finishedSink->stop();
         finishedSink->deleteLater();
       }
-      if (finishedBuffer) {
-        finishedBuffer->close();
-        finishedBuffer->deleteLater();
+      if (finishedSource) {
+        finishedSource->close();
+        finishedSource->deleteLater();
       }
       continue;
     }
@@ -4945,6 +5666,9 @@ void MainWindow::refreshPlaybackHandles() {
 }
 
 void MainWindow::openStructMembersForPath(const QString& path) {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   if (path.isEmpty()) {
     return;
   }
@@ -4973,6 +5697,9 @@ void MainWindow::openStructMembersForPath(const QString& path) {
 }
 
 void MainWindow::openCellMembersForPath(const QString& path) {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   if (path.isEmpty()) {
     return;
   }
@@ -4998,6 +5725,7 @@ void MainWindow::trackWindow(const QString& varName, QWidget* window, WindowKind
   s.scope = engine_.activeContext();
   s.kind = kind;
   s.window = window;
+  s.dataVersion = variableBacked ? engine_.variableVersion(varName.toStdString()) : 0;
   scopedWindows_.push_back(s);
   window->installEventFilter(this);
   auto* graphWindow = qobject_cast<SignalGraphWindow*>(window);
@@ -5241,7 +5969,15 @@ std::vector<VarSnapshot> MainWindow::graphicsHandleMembersForId(std::uint64_t ha
     out.push_back(makeSnapshot(QStringLiteral("ygrid"), QStringLiteral("SCLR"), QStringLiteral("1"), graphicsHandleProperty(handleId, QStringLiteral("ygrid"))));
   } else if (typeName == "line") {
     out.push_back(makeSnapshot(QStringLiteral("xdata"), QStringLiteral("VECT"), QStringLiteral("?"), graphicsHandleProperty(handleId, QStringLiteral("xdata"))));
-    out.push_back(makeSnapshot(QStringLiteral("ydata"), QStringLiteral("VECT"), QStringLiteral("?"), graphicsHandleProperty(handleId, QStringLiteral("ydata"))));
+    // A preview of the leading samples; a paged line would otherwise be fetched whole.
+    const SignalGraphWindow* owner = graphWindowForHandle(handleId);
+    const int ycount = owner ? owner->lineSampleCount(handleId) : 0;
+    const auto ypreview = owner ? owner->lineYData(handleId, kHandleSnapshotPreviewValues) : std::nullopt;
+    QString ytext = ypreview ? formatDoubleVector(*ypreview) : QStringLiteral("[]");
+    if (ypreview && ycount > ypreview->size()) {
+      ytext.insert(ytext.size() - 1, QStringLiteral(" ..."));
+    }
+    out.push_back(makeSnapshot(QStringLiteral("ydata"), QStringLiteral("VECT"), QString::number(ycount), ytext));
     out.push_back(makeSnapshot(QStringLiteral("linewidth"), QStringLiteral("SCLR"), QStringLiteral("1"), graphicsHandleProperty(handleId, QStringLiteral("linewidth"))));
     out.push_back(makeSnapshot(QStringLiteral("linestyle"), QStringLiteral("TEXT"), QStringLiteral("1"), graphicsHandleProperty(handleId, QStringLiteral("linestyle"))));
     out.push_back(makeSnapshot(QStringLiteral("marker"), QStringLiteral("TEXT"), QStringLiteral("1"), graphicsHandleProperty(handleId, QStringLiteral("marker"))));
@@ -5316,7 +6052,10 @@ QString MainWindow::graphicsHandleProperty(std::uint64_t handleId, const QString
     if (key == "type") return QStringLiteral("\"line\"");
     if (const QString value = commonGetter(line->common); !value.isEmpty()) return value;
     if (key == "xdata") return formatDoubleVector(line->xdata);
-    if (key == "ydata") return formatDoubleVector(line->ydata);
+    if (key == "ydata") {
+      const auto ydata = owner->lineYData(handleId);
+      return ydata ? formatDoubleVector(*ydata) : QStringLiteral("Error: line samples are unavailable while the engine is busy.");
+    }
     if (key == "linewidth") return QString::number(line->lineWidth);
     if (key == "linestyle") return QString("\"%1\"").arg(line->lineStyle);
     if (key == "marker") return QString("\"%1\"").arg(line->marker);
@@ -5401,6 +6140,9 @@ void MainWindow::focusWindow(QWidget* window) const {
 }
 
 void MainWindow::reconcileScopedWindows() {
+  if (engineBusy()) {
+    return;
+  }
   graphicsManager_.reconcile();
   std::unordered_set<std::string> activeNames;
   for (const auto& v : engine_.listVariables()) {
@@ -5442,9 +6184,18 @@ void MainWindow::reconcileScopedWindows() {
     if (auto* g = qobject_cast<SignalGraphWindow*>(it->window.data())) {
       g->setWorkspaceActive(it->scope == currentScope);
       if (it->scope == currentScope) {
-        auto sig = engine_.getSignalData(it->varName.toStdString());
-        if (sig) {
-          g->updateData(*sig);
+        // Skip the copy when the variable has not changed since the last refresh.
+        const std::uint64_t version = engine_.variableVersion(it->varName.toStdString());
+        if (version == 0 || version != it->dataVersion) {
+          if (g->isPaged()) {
+            if (const auto info = engine_.getSignalInfo(it->varName.toStdString())) {
+              attachPagedSource(g, it->varName, *info);
+              it->dataVersion = version;
+            }
+          } else if (auto sig = engine_.getSignalData(it->varName.toStdString())) {
+            g->updateData(*sig);
+            it->dataVersion = version;
+          }
         }
       }
     } else {
@@ -5579,12 +6330,12 @@ void MainWindow::noteScopedWindowFocus(QWidget* window) {
 }
 
 bool MainWindow::variableSupportsSignalDisplay(const QString& varName) const {
-  auto sig = engine_.getSignalData(varName.toStdString());
+  auto sig = engine_.getSignalInfo(varName.toStdString());
   return sig.has_value();
 }
 
 bool MainWindow::variableIsAudio(const QString& varName) const {
-  auto sig = engine_.getSignalData(varName.toStdString());
+  auto sig = engine_.getSignalInfo(varName.toStdString());
   return sig.has_value() && sig->isAudio;
 }
 
@@ -5605,6 +6356,9 @@ bool MainWindow::variableIsCell(const QString& varName) const {
 }
 
 void MainWindow::handleDebugAction(auxDebugAction action) {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   reloadCurrentUdfIfStale("Reloaded after external edit");
   engine_.debugResume(action);
   refreshVariables();
@@ -5613,6 +6367,9 @@ void MainWindow::handleDebugAction(auxDebugAction action) {
 }
 
 void MainWindow::showSettingsDialog() {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   const RuntimeSettingsSnapshot cfg = engine_.runtimeSettings();
   QDialog dialog(this);
   dialog.setWindowTitle("Runtime Settings");
@@ -5652,6 +6409,39 @@ void MainWindow::showSettingsDialog() {
                                             kMinAsyncCapturePollMs,
                                             kMaxAsyncCapturePollMs));
 
+  auto* backgroundEvalCheck = new QCheckBox("Evaluate commands in background (Ctrl+C interrupts)", &dialog);
+  backgroundEvalCheck->setChecked(backgroundEval_);
+  backgroundEvalCheck->setToolTip("Ctrl+C stops a running command at its next graphics, playback or recording call; "
+                                  "pure computation cannot be interrupted.");
+
+  auto* welchCheck = new QCheckBox("Average short segments (Welch) instead of one FFT over the view", &dialog);
+  welchCheck->setChecked(welchSpectrum_);
+
+  auto* welchSegmentCombo = new QComboBox(&dialog);
+  for (int log2 = kMinWelchSegmentLog2; log2 <= kMaxWelchSegmentLog2; ++log2) {
+    welchSegmentCombo->addItem(QString::number(1 << log2), 1 << log2);
+  }
+  welchSegmentCombo->setCurrentIndex(std::max(0, welchSegmentCombo->findData(welchOptions_.segmentSize)));
+
+  auto* welchOverlapSpin = new QSpinBox(&dialog);
+  welchOverlapSpin->setRange(0, 90);
+  welchOverlapSpin->setSuffix(" %");
+  welchOverlapSpin->setValue(static_cast<int>(std::lround(welchOptions_.overlap * 100.0)));
+
+  auto* welchWindowCombo = new QComboBox(&dialog);
+  welchWindowCombo->addItem("Rectangular", static_cast<int>(SpectrumWindow::Rectangular));
+  welchWindowCombo->addItem("Hann", static_cast<int>(SpectrumWindow::Hann));
+  welchWindowCombo->addItem("Hamming", static_cast<int>(SpectrumWindow::Hamming));
+  welchWindowCombo->setCurrentIndex(std::max(0, welchWindowCombo->findData(static_cast<int>(welchOptions_.window))));
+
+  auto* resampleQualityCombo = new QComboBox(&dialog);
+  resampleQualityCombo->addItem("Best (sinc)", static_cast<int>(ResampleQuality::Best));
+  resampleQualityCombo->addItem("Medium (sinc)", static_cast<int>(ResampleQuality::Medium));
+  resampleQualityCombo->addItem("Fastest (sinc)", static_cast<int>(ResampleQuality::Fastest));
+  resampleQualityCombo->addItem("Linear", static_cast<int>(ResampleQuality::Linear));
+  resampleQualityCombo->setCurrentIndex(
+      std::max(0, resampleQualityCombo->findData(static_cast<int>(recordResampleQuality_))));
+
   auto* udfPathsEdit = new QPlainTextEdit(&dialog);
   QStringList pathLines;
   for (const std::string& p : cfg.udfPaths) {
@@ -5667,6 +6457,12 @@ void MainWindow::showSettingsDialog() {
   form->addRow("Display Limit String", limitStrSpin);
   form->addRow("Display Precision", precisionSpin);
   form->addRow("Callback Capture Poll", asyncCapturePollSpin);
+  form->addRow("Command Evaluation", backgroundEvalCheck);
+  form->addRow("FFT Overlay", welchCheck);
+  form->addRow("FFT Segment Size", welchSegmentCombo);
+  form->addRow("FFT Segment Overlap", welchOverlapSpin);
+  form->addRow("FFT Window", welchWindowCombo);
+  form->addRow("Recording Resampler", resampleQualityCombo);
   form->addRow("UDF Paths (one per line)", udfPathsEdit);
   layout->addLayout(form);
 
@@ -5707,14 +6503,35 @@ void MainWindow::showSettingsDialog() {
   }
 
   asyncCapturePollMs_ = nextAsyncCapturePollMs;
+  backgroundEval_ = backgroundEvalCheck->isChecked();
+  recordResampleQuality_ = static_cast<ResampleQuality>(resampleQualityCombo->currentData().toInt());
   if (asyncPollTimer_) {
     asyncPollTimer_->setInterval(asyncCapturePollMs_);
   }
+  WelchOptions nextWelch = welchOptions_;
+  nextWelch.segmentSize = welchSegmentCombo->currentData().toInt();
+  nextWelch.overlap = welchOverlapSpin->value() / 100.0;
+  nextWelch.window = static_cast<SpectrumWindow>(welchWindowCombo->currentData().toInt());
+  const bool spectrumChanged = welchCheck->isChecked() != welchSpectrum_ ||
+                               nextWelch.segmentSize != welchOptions_.segmentSize ||
+                               nextWelch.overlap != welchOptions_.overlap || nextWelch.window != welchOptions_.window;
+  welchSpectrum_ = welchCheck->isChecked();
+  welchOptions_ = nextWelch;
+  if (spectrumChanged) {
+    for (const auto& entry : scopedWindows_) {
+      if (auto* g = qobject_cast<SignalGraphWindow*>(entry.window.data())) {
+        g->setSpectrumOptions(spectrumOptions());
+      }
+    }
+  }
   savePersistedRuntimeSettings();
   statusBar()->showMessage("Runtime settings updated.", 2500);
 }
 
 void MainWindow::showAboutDialog() {
+  if (rejectWhileEngineBusy()) {
+    return;
+  }
   QString auxeVersion = QString::fromStdString(engine_.engineVersion());
   if (auxeVersion.trimmed().isEmpty()) {
     auxeVersion = AUXE_VERSION;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AudioResampler.h"
 #include "AuxEngineFacade.h"
 #include "GraphicsManager.h"
 
@@ -15,7 +16,10 @@
 #include <QTimer>
 #include <QVector>
 #include <array>
+#include <atomic>
+#include <deque>
 #include <map>
+#include <memory>
 
 class QListWidget;
 class QListWidgetItem;
@@ -27,7 +31,10 @@ class QAction;
 class QMenu;
 class QSplitter;
 class QFileSystemWatcher;
+class QThread;
 class AudioCaptureSink;
+class CaptureWorker;
+class LoopingPcmSource;
 class CommandConsole;
 class SignalGraphWindow;
 class SignalTableWindow;
@@ -65,6 +72,9 @@ public:
                    double durationMs,
                    auxRecordResult& result,
                    std::string& err);
+  bool backendCallInterrupted(std::string& err) const;
+  void setBackendCallActive(bool active);
+  bool isShuttingDown() const { return shuttingDown_; }
 
 protected:
   bool eventFilter(QObject* watched, QEvent* event) override;
@@ -83,6 +93,12 @@ private:
     auxContext* scope = nullptr;
     WindowKind kind = WindowKind::Graph;
     QPointer<QWidget> window;
+    std::uint64_t dataVersion = 0;
+  };
+
+  struct PendingCommand {
+    QString text;
+    bool addToHistory = true;
   };
 
   void buildUi();
@@ -90,6 +106,13 @@ private:
   void connectSignals();
 
   void runCommand(const QString& cmd, bool addToHistory = true);
+  void finishEvaluatedCommand(const QString& actual, EvalResult result);
+  void startBackgroundEval(const QString& actual);
+  void onBackgroundEvalFinished(const QString& actual, const EvalResult& result);
+  void echoCommandResult(const QString& output);
+  void interruptEvaluation();
+  bool engineBusy() const;
+  bool rejectWhileEngineBusy();
   bool tryHandleGraphicsCommand(const QString& cmd, QString& output);
   void onAsyncPollTick();
   void processRecordingSessions();
@@ -128,6 +151,9 @@ private:
                                              bool namedPlot,
                                              const QString& sourcePath,
                                              bool variableBacked);
+  void attachPagedSource(SignalGraphWindow* window, const QString& path, const SignalInfo& info);
+  std::vector<std::vector<double>> signalSpectrumDb(const QString& path, int viewStart, int viewLen) const;
+  WelchOptions spectrumOptions() const;
   bool openGraphicsPathDetail(const QString& path);
   void openPathDetail(const QString& path);
   void playAudioForPath(const QString& path);
@@ -227,14 +253,13 @@ private:
   struct PlaybackSession {
     std::uint64_t handleId = 0;
     QAudioSink* sink = nullptr;
-    QBuffer* buffer = nullptr;
-    QByteArray pcmData;
+    // Holds one pass of each queued play() and loops it; kept across pause/resume.
+    LoopingPcmSource* source = nullptr;
     int sampleRate = 0;
     int channelCount = 0;
     int totalFrames = 0;
     int repeatCount = 1;
     double durationMs = 0.0;
-    std::vector<int> segmentEndFrames;
     qint64 pausedBytes = 0;
     bool paused = false;
   };
@@ -259,16 +284,20 @@ private:
     double durationMs = -1.0;
     double blockMs = 100.0;
     int remainingDurationMs = -1;
-    qsizetype rawBytesConsumed = 0;
     qsizetype outputFramesProduced = 0;
-    std::vector<double> capturedInterleaved;
-    std::vector<double> pendingConvertedInterleaved;
-    std::vector<std::vector<double>> readyBlocks;
+    // Converts the capture into blocks off the GUI thread; see CaptureWorker.
+    std::unique_ptr<CaptureWorker> worker;
+    std::deque<std::vector<double>> readyBlocks;
     bool active = false;
     bool paused = false;
     bool stopDueToTimeout = false;
+    // Set once the console has been told that this session's capture ring overflowed.
+    bool droppedWarned = false;
   };
 
+  // Sets the durDropped member and warns once per session when input frames were lost.
+  void noteDroppedCaptureFrames(RecordingSession& session, std::map<std::string, double>& members, QStringList& messages);
+
   std::map<std::uint64_t, RecordingSession> recordingSessions_;
   std::uint64_t lastStartedAsyncRecordHandle_ = 0;
   QString lastStartedAsyncRecordCallback_;
@@ -284,5 +313,21 @@ private:
   QStringList recentUdfFiles_;
   QTimer* asyncPollTimer_ = nullptr;
   int asyncCapturePollMs_ = 300;
+  // FFT overlay: one transform over the whole view, or a Welch average with a
+  // bounded transform size. Paged windows go through signalSpectrumDb; the others
+  // compute from their own samples with spectrumOptions().
+  bool welchSpectrum_ = false;
+  WelchOptions welchOptions_;
+  ResampleQuality recordResampleQuality_ = ResampleQuality::Medium;
   bool suppressWindowActivation_ = false;
+
+  QThread* evalThread_ = nullptr;
+  QObject* evalWorker_ = nullptr;
+  bool backgroundEval_ = false;
+  bool evalInFlight_ = false;
+  bool closePending_ = false;
+  bool shuttingDown_ = false;
+  int backendCallDepth_ = 0;
+  std::atomic<bool> evalInterruptRequested_{false};
+  std::deque<PendingCommand> pendingCommands_;
 };
@@ -17,6 +17,25 @@
 
 namespace {
 constexpr double kRmsDbOffset = 3.0103;
+// Upper bound on values held per channel by a paged window (raw samples or min/max pairs).
+constexpr int kPageBudgetSamples = 1 << 21;
+// Samples the paged energy index fetches per timer tick, over all channels.
+constexpr int kPagedRmsChunkSamples = 1 << 20;
+// Block size of a paged window's energy index; a range query fetches at most two
+// partial blocks.
+constexpr int kPagedEnergyBlock = 4096;
+// Buffers shorter than this are scanned directly; a pyramid would not pay for itself.
+constexpr int kLodMinSamples = 1 << 16;
+// FFT requests wait this long for the view to settle before a spectrum is computed.
+constexpr int kFftComputeDelayMs = 60;
+// Spectra cached per (view, channel).
+constexpr size_t kFftCacheEntries = 16;
+// Upper bound on frames converted per read by the playback source.
+constexpr int kPcmChunkFrames = 4096;
+// Paged playback keeps up to this much audio fetched ahead of the read position and
+// tops it up once less than half remains, so a briefly busy engine does not starve it.
+constexpr int kPlaybackPrefetchSeconds = 8;
+constexpr int kPlaybackErrorMs = 5000;
 
 Qt::PenStyle penStyleForLine(const QString& lineStyle) {
   if (lineStyle == "--") {
@@ -85,6 +104,12 @@ void drawMarker(QPainter& p, const QPointF& pt, const QString& marker, int marke
   }
 }
 
+int viewSampleToX(const QRect& plot, int sample, int viewStart, int viewLen) {
+  const int total = std::max(1, viewLen - 1);
+  const double frac = std::clamp((sample - viewStart) / static_cast<double>(total), 0.0, 1.0);
+  return plot.left() + static_cast<int>(std::llround(frac * plot.width()));
+}
+
 int timelineOffsetSamples(const SignalData& data) {
   if (!data.isAudio || data.sampleRate <= 0) {
     return 0;
@@ -92,13 +117,6 @@ int timelineOffsetSamples(const SignalData& data) {
   return std::max(0, static_cast<int>(std::llround(data.startTimeSec * data.sampleRate)));
 }
 
-int totalTimelineSamples(const SignalData& data) {
-  if (data.channels.empty()) {
-    return 0;
-  }
-  return timelineOffsetSamples(data) + static_cast<int>(data.channels.front().samples.size());
-}
-
 std::array<double, 4> qtRectToMatlabFigurePos(const QRect& rect) {
   const QRect screen = QGuiApplication::primaryScreen()
                            ? QGuiApplication::primaryScreen()->availableGeometry()
@@ -195,8 +213,211 @@ QString formatSecondsCompact(double sec) {
   }
   return trimTrailingZeros(QString::number(clamped, 'f', 3));
 }
+
+// Sum of squares of fetched samples, with gaps (NaN) counted as silence.
+double finiteSumOfSquares(std::vector<double>& samples, size_t from, size_t count) {
+  for (size_t i = from; i < from + count; ++i) {
+    if (!std::isfinite(samples[i])) {
+      samples[i] = 0.0;
+    }
+  }
+  return sumOfSquares(samples.data() + from, count);
+}
 }  // namespace
 
+// Read-only Int16 PCM over timeline samples [start, end) of a signal, converted a chunk
+// at a time inside readData. Samples before the data offset and gaps play as silence.
+// With a prefetch size the source reads through a buffer filled ahead of the play
+// position (paged signals, whose samples come from the engine); when the buffer runs
+// dry and the fetcher cannot deliver, the stream ends and onStarved is called.
+class SignalPcmSource final : public QIODevice {
+public:
+  // Returns `length` samples of `channel` from data sample `start`; gaps as 0 or NaN.
+  // An empty result for a non-empty request means the samples are unavailable.
+  using Fetcher = std::function<std::vector<double>(int channel, int start, int length)>;
+
+  SignalPcmSource(int channelCount,
+                  int dataOffset,
+                  int dataLength,
+                  int start,
+                  int end,
+                  Fetcher fetch,
+                  int prefetchFrames,
+                  QObject* parent = nullptr)
+      : QIODevice(parent),
+        channelCount_(std::max(1, channelCount)),
+        dataOffset_(dataOffset),
+        dataLength_(std::max(0, dataLength)),
+        start_(start),
+        end_(std::max(start, end)),
+        fetch_(std::move(fetch)),
+        prefetchFrames_(std::max(0, prefetchFrames)),
+        ahead_(static_cast<size_t>(channelCount_)) {}
+
+  // Unbuffered so pos() in readData is the position the sink is reading.
+  bool open(OpenMode mode) override { return QIODevice::open(mode | QIODevice::Unbuffered); }
+  bool isSequential() const override { return false; }
+  qint64 size() const override { return static_cast<qint64>(end_ - start_) * frameBytes(); }
+
+  bool seekToSample(int sample) {
+    return seek(static_cast<qint64>(std::clamp(sample, start_, end_) - start_) * frameBytes());
+  }
+
+  // Fills the prefetch buffer from the current position; false if the fetcher could not.
+  bool prefetch() {
+    if (prefetchFrames_ <= 0) {
+      return true;
+    }
+    const int first = std::max(start_ + static_cast<int>(pos() / frameBytes()), dataOffset_) - dataOffset_;
+    return first >= dataLength_ || refill(first, std::min(prefetchFrames_, dataLength_ - first));
+  }
+
+  std::function<void()> onStarved;
+
+protected:
+  qint64 readData(char* data, qint64 maxlen) override {
+    const qint64 frameBytesValue = frameBytes();
+    const int first = start_ + static_cast<int>(pos() / frameBytesValue);
+    const int frames = static_cast<int>(std::min<qint64>({maxlen / frameBytesValue,
+                                                           static_cast<qint64>(end_ - first),
+                                                           static_cast<qint64>(kPcmChunkFrames)}));
+    if (frames <= 0) {
+      return 0;
+    }
+
+    auto* out = reinterpret_cast<qint16*>(data);
+    std::fill_n(out, static_cast<size_t>(frames) * channelCount_, qint16(0));
+    const int dataFirst = std::max(first, dataOffset_);
+    const int lead = dataFirst - first;
+    const int count = std::min(frames - lead, dataLength_ - (dataFirst - dataOffset_));
+    if (count > 0 && fetch_) {
+      const int from = dataFirst - dataOffset_;
+      if (prefetchFrames_ > 0 && !ensureAhead(from, count)) {
+        if (onStarved) {
+          onStarved();
+        }
+        return 0;
+      }
+      for (int c = 0; c < channelCount_; ++c) {
+        std::vector<double> fetched;
+        const double* src = nullptr;
+        int n = count;
+        if (prefetchFrames_ > 0) {
+          src = ahead_[static_cast<size_t>(c)].data() + (from - aheadStart_);
+        } else {
+          fetched = fetch_(c, from, count);
+          src = fetched.data();
+          n = std::min(count, static_cast<int>(fetched.size()));
+        }
+        for (int i = 0; i < n; ++i) {
+          double v = src[i];
+          v = std::isfinite(v) ? std::clamp(v, -1.0, 1.0) : 0.0;
+          out[static_cast<size_t>(lead + i) * channelCount_ + c] = static_cast<qint16>(std::lrint(v * 32767.0));
+        }
+      }
+    }
+    return static_cast<qint64>(frames) * frameBytesValue;
+  }
+
+  qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+  qint64 frameBytes() const { return static_cast<qint64>(channelCount_) * static_cast<qint64>(sizeof(qint16)); }
+
+  int aheadEnd() const { return aheadStart_ + aheadLength_; }
+
+  // Makes data samples [from, from + count) available in ahead_, and tops the buffer
+  // up when less than half a prefetch remains past them. Only a miss on the samples
+  // needed now fails; a failed top-up is retried on the next read.
+  bool ensureAhead(int from, int count) {
+    if (from < aheadStart_ || from + count > aheadEnd()) {
+      return refill(from, std::clamp(prefetchFrames_, count, dataLength_ - from));
+    }
+    const int remaining = aheadEnd() - (from + count);
+    if (remaining < prefetchFrames_ / 2 && aheadEnd() < dataLength_) {
+      extend(from, std::min(prefetchFrames_ / 2, dataLength_ - aheadEnd()));
+    }
+    return true;
+  }
+
+  bool refill(int from, int length) {
+    std::vector<std::vector<double>> next(static_cast<size_t>(channelCount_));
+    for (int c = 0; c < channelCount_; ++c) {
+      next[static_cast<size_t>(c)] = fetch_(c, from, length);
+      if (static_cast<int>(next[static_cast<size_t>(c)].size()) < length) {
+        return false;
+      }
+    }
+    ahead_ = std::move(next);
+    aheadStart_ = from;
+    aheadLength_ = length;
+    return true;
+  }
+
+  // Appends `length` samples after the buffer and drops what was played before `keepFrom`.
+  void extend(int keepFrom, int length) {
+    std::vector<std::vector<double>> more(static_cast<size_t>(channelCount_));
+    for (int c = 0; c < channelCount_; ++c) {
+      more[static_cast<size_t>(c)] = fetch_(c, aheadEnd(), length);
+      if (static_cast<int>(more[static_cast<size_t>(c)].size()) < length) {
+        return;
+      }
+    }
+    const int drop = keepFrom - aheadStart_;
+    for (int c = 0; c < channelCount_; ++c) {
+      auto& buf = ahead_[static_cast<size_t>(c)];
+      buf.erase(buf.begin(), buf.begin() + drop);
+      buf.insert(buf.end(), more[static_cast<size_t>(c)].begin(), more[static_cast<size_t>(c)].end());
+    }
+    aheadStart_ = keepFrom;
+    aheadLength_ += length - drop;
+  }
+
+  int channelCount_;
+  int dataOffset_;
+  int dataLength_;
+  int start_;
+  int end_;
+  Fetcher fetch_;
+  int prefetchFrames_;
+  std::vector<std::vector<double>> ahead_;
+  int aheadStart_ = 0;
+  int aheadLength_ = 0;
+};
+
+// Snapshot of everything renderStaticLayer reads, so a frame can render off the GUI
+// thread. Sample buffers are implicitly shared with the window, not copied.
+struct SignalGraphWindow::LayerScene {
+  explicit LayerScene(GraphicsFigureModel graphicsIn) : graphics(std::move(graphicsIn)) {}
+
+  LayerKey key;
+  GraphicsFigureModel graphics;
+  SignalData data;
+  bool paged = false;
+  std::shared_ptr<const SamplePage> page;
+  int dataLength = 0;
+  std::unordered_map<std::uint64_t, SampleLod> lineLods;
+  std::unordered_map<std::uint64_t, LineXOrder> lineXOrders;
+  std::vector<SampleLod> channelLods;
+  // Scroll source: the previous frame's traces move by scrollColumns (positive when
+  // the view moved right) and only the exposed columns are drawn.
+  std::vector<AxesTraces> previousTraces;
+  int scrollColumns = 0;
+  double traceDrift = 0.0;
+  std::vector<AxesTraces> traces;
+  std::uint64_t generation = 0;
+  const std::atomic<std::uint64_t>* latestGeneration = nullptr;
+
+  bool cancelled() const { return latestGeneration && latestGeneration->load() != generation; }
+};
+
+bool SignalGraphWindow::LayerKey::operator==(const LayerKey& other) const {
+  return size == other.size && plot == other.plot && dataSerial == other.dataSerial &&
+         layerSerial == other.layerSerial && viewStart == other.viewStart && viewLen == other.viewLen &&
+         std::fabs(yMin - other.yMin) <= 1e-12 && std::fabs(yMax - other.yMax) <= 1e-12 &&
+         stereoMode == other.stereoMode && workspaceActive == other.workspaceActive;
+}
+
 SignalGraphWindow::SignalGraphWindow(const QString& varName,
                                      const SignalData& data,
                                      CreationOptions options,
@@ -217,10 +438,11 @@ SignalGraphWindow::SignalGraphWindow(const QString& varName,
   syncFigurePosFromWidget();
   setFocusPolicy(Qt::StrongFocus);
   setMouseTracking(true);
+  renderPool_.setMaxThreadCount(1);
 
   if (!data_.channels.empty()) {
     viewStart_ = 0;
-    viewLen_ = std::max(1, totalTimelineSamples(data_));
+    viewLen_ = std::max(1, timelineLength());
     fftPaneOffsets_.assign(data_.channels.size(), QPoint(0, 0));
     rangeHistory_.push_back({viewStart_, viewStart_ + viewLen_});
     rangeHistoryIndex_ = 0;
@@ -247,6 +469,13 @@ SignalGraphWindow::SignalGraphWindow(const QString& varName,
   bindRangeShortcut(QKeySequence(rangeModifier | Qt::Key_Comma), [this]() { stepRangeHistory(-1); });
   bindRangeShortcut(QKeySequence(rangeModifier | Qt::Key_Period), [this]() { stepRangeHistory(+1); });
 
+  pagedEnergyTimer_.setSingleShot(true);
+  connect(&pagedEnergyTimer_, &QTimer::timeout, this, &SignalGraphWindow::fillPagedEnergy);
+
+  fftComputeTimer_.setSingleShot(true);
+  fftComputeTimer_.setInterval(kFftComputeDelayMs);
+  connect(&fftComputeTimer_, &QTimer::timeout, this, &SignalGraphWindow::computePendingFft);
+
   fftMoveHoldTimer_.setSingleShot(true);
   fftMoveHoldTimer_.setInterval(2000);
   connect(&fftMoveHoldTimer_, &QTimer::timeout, this, [this]() {
@@ -258,6 +487,8 @@ SignalGraphWindow::SignalGraphWindow(const QString& varName,
 }
 
 SignalGraphWindow::~SignalGraphWindow() {
+  ++fftGeneration_;
+  cancelStaticLayerRender();
   stopPlayback();
 }
 
@@ -273,23 +504,41 @@ void SignalGraphWindow::setWorkspaceActive(bool active) {
 }
 
 void SignalGraphWindow::updateData(const SignalData& data) {
-  const int oldTotalLen = totalTimelineSamples(data_);
+  replaceData(data, {}, 0);
+}
+
+void SignalGraphWindow::setPagedSource(const SignalInfo& info, SampleWindowProvider provider) {
+  replaceData(signalOutline(info), std::move(provider), info.totalSamples);
+}
+
+void SignalGraphWindow::replaceData(const SignalData& data, SampleWindowProvider provider, int pagedDataLen) {
+  const int oldTotalLen = timelineLength();
   const int oldViewEnd = viewStart_ + std::max(0, viewLen_);
   const bool wasNearFullView =
       (oldTotalLen > 0 && viewStart_ <= 1 && oldViewEnd >= oldTotalLen - 1);
-  const bool hadNoUsablePriorView = (oldTotalLen <= 0 || viewLen_ <= 0);
+  const bool hadNoUsablePriorView = (oldTotalLen <= 0 || viewLen_ <= 0 || isPaged() != static_cast<bool>(provider));
 
   data_ = data;
+  pageProvider_ = std::move(provider);
+  pagedDataLen_ = pageProvider_ ? std::max(0, pagedDataLen) : 0;
+  page_.reset();
+  pagedRmsSerial_ = -1;
+  lineLods_.clear();
+  lineXOrders_.clear();
+  channelLods_.assign(data_.channels.size(), SampleLod());
   graphics_.updateSignalData(data_);
   setWindowTitle(graphics_.figure().title);
   ++dataSerial_;
+  ++fftGeneration_;
   fftComputed_ = false;
   fftDb_.clear();
+  fftPendingChannels_.clear();
   fftViewStart_ = -1;
   fftViewLen_ = -1;
   fftDataSerial_ = -1;
+  fftCache_.clear();
   if (!data_.channels.empty()) {
-    const int totalLen = std::max(1, totalTimelineSamples(data_));
+    const int totalLen = std::max(1, timelineLength());
     if (wasNearFullView || hadNoUsablePriorView) {
       // Keep showing the whole signal when user was viewing full extent.
       viewStart_ = 0;
@@ -323,6 +572,41 @@ std::uint64_t SignalGraphWindow::addAxes(const std::array<double, 4>& pos) {
   return axesId;
 }
 
+int SignalGraphWindow::lineSampleCount(std::uint64_t lineId) const {
+  const auto* line = graphics_.lineById(lineId);
+  if (!line) {
+    return 0;
+  }
+  if (!line->ydata.isEmpty() || line->logicalChannel < 0 ||
+      line->logicalChannel >= static_cast<int>(data_.channels.size())) {
+    return static_cast<int>(line->ydata.size());
+  }
+  return isPaged() ? pagedDataLen_ : channelLength(data_.channels[static_cast<size_t>(line->logicalChannel)]);
+}
+
+std::optional<QVector<double>> SignalGraphWindow::lineYData(std::uint64_t lineId, int maxCount) const {
+  const auto* line = graphics_.lineById(lineId);
+  if (!line) {
+    return std::nullopt;
+  }
+  const int total = lineSampleCount(lineId);
+  const int count = maxCount > 0 ? std::min(total, maxCount) : total;
+  if (!line->ydata.isEmpty() || count <= 0) {
+    QVector<double> out = line->ydata;
+    out.resize(count);
+    return out;
+  }
+  const int channel = line->logicalChannel;
+  const std::vector<double> samples =
+      isPaged() ? pageProvider_(channel, 0, count, 1)
+                : copyChannelWindow(data_.channels[static_cast<size_t>(channel)], 0, count,
+                                    std::numeric_limits<double>::quiet_NaN());
+  if (static_cast<int>(samples.size()) < count) {
+    return std::nullopt;
+  }
+  return QVector<double>(samples.begin(), samples.end());
+}
+
 std::uint64_t SignalGraphWindow::addLine(std::uint64_t axesId, const QVector<double>& xdata, const QVector<double>& ydata) {
   const auto lineId = graphics_.addLine(axesId, xdata, ydata);
   if (lineId == 0) {
@@ -363,6 +647,8 @@ bool SignalGraphWindow::removeLine(std::uint64_t lineId) {
   if (!graphics_.removeLine(lineId)) {
     return false;
   }
+  lineLods_.erase(lineId);
+  lineXOrders_.erase(lineId);
   updateYRange();
   invalidateStaticLayer();
   update();
@@ -388,11 +674,15 @@ void SignalGraphWindow::applyStyleToAllLines(const std::optional<QColor>& color,
 
 void SignalGraphWindow::applyXDataToAllLines(const QVector<double>& xdata) {
   graphics_.applyXDataToAllLines(xdata);
+  lineXOrders_.clear();
   invalidateStaticLayer();
   update();
 }
 
 void SignalGraphWindow::refreshGraphics() {
+  // Line data may have been replaced through handle properties.
+  lineLods_.clear();
+  lineXOrders_.clear();
   syncFigurePosFromWidget();
   updateYRange();
   invalidateStaticLayer();
@@ -441,9 +731,7 @@ void SignalGraphWindow::paintEvent(QPaintEvent*) {
 
   const QRect plot = plotRect();
   ensureStaticLayer(plot);
-  if (!staticLayer_.isNull()) {
-    p.drawImage(QPoint(0, 0), staticLayer_);
-  }
+  drawStaticLayer(p, plot);
 
   if (selStart_ >= 0 && selEnd_ >= 0 && selStart_ != selEnd_) {
     const int s = std::min(selStart_, selEnd_);
@@ -477,14 +765,14 @@ void SignalGraphWindow::paintEvent(QPaintEvent*) {
 }
 
 SignalGraphWindow::Range SignalGraphWindow::clampRange(const Range& range) const {
-  const int totalLen = std::max(1, totalTimelineSamples(data_));
+  const int totalLen = std::max(1, timelineLength());
   const int start = std::clamp(range.start, 0, std::max(0, totalLen - 1));
   const int end = std::clamp(range.end, start + 1, totalLen);
   return {start, end};
 }
 
 SignalGraphWindow::Range SignalGraphWindow::fullRange() const {
-  const int totalLen = std::max(1, totalTimelineSamples(data_));
+  const int totalLen = std::max(1, timelineLength());
   return {0, totalLen};
 }
 
@@ -517,7 +805,6 @@ void SignalGraphWindow::applyRange(const Range& range, bool recordHistory) {
   handlePlaybackAfterRangeChange();
   syncVisibleXRangeToAxes();
   updateYRange();
-  invalidateStaticLayer();
   update();
 }
 
@@ -539,7 +826,7 @@ void SignalGraphWindow::anchorRangeStartToZero() {
 }
 
 void SignalGraphWindow::anchorRangeEndToSignalEnd() {
-  const int totalLen = std::max(1, totalTimelineSamples(data_));
+  const int totalLen = std::max(1, timelineLength());
   const int currentLen = std::max(1, viewLen_);
   applyRange({totalLen - currentLen, totalLen});
 }
@@ -733,7 +1020,7 @@ void SignalGraphWindow::leaveEvent(QEvent* event) {
   QWidget::leaveEvent(event);
 }
 
-QRect SignalGraphWindow::axesRectForPlot(const GraphicsAxesHandle& axes, const QRect& plot) const {
+QRect SignalGraphWindow::axesRectForPlot(const GraphicsAxesHandle& axes, const QRect& plot) {
   const auto& pos = axes.common.pos;
   const int left = plot.left() + static_cast<int>(std::llround(pos[0] * plot.width()));
   const int width = static_cast<int>(std::llround(pos[2] * plot.width()));
@@ -743,12 +1030,22 @@ QRect SignalGraphWindow::axesRectForPlot(const GraphicsAxesHandle& axes, const Q
   return QRect(left, top, width, height);
 }
 
-void SignalGraphWindow::drawLine(QPainter& p, const QRect& area, const GraphicsAxesHandle& axes, const GraphicsLineHandle& line) {
+void SignalGraphWindow::drawLine(LayerScene& scene,
+                                 QPainter& p,
+                                 const QRect& area,
+                                 const GraphicsAxesHandle& axes,
+                                 const GraphicsLineHandle& line,
+                                 int columnFrom,
+                                 int columnTo) {
+  const SignalData& data = scene.data;
+  const int viewStart = scene.key.viewStart;
+  const int viewLen = scene.key.viewLen;
   const QVector<double>& xdata = line.xdata;
   const QVector<double>& ydata = line.ydata;
-  const bool deriveAudioX = data_.isAudio && data_.sampleRate > 0 && xdata.isEmpty();
+  const bool deriveAudioX = data.isAudio && data.sampleRate > 0 && xdata.isEmpty();
   const bool manualAudioX = deriveAudioX && !axes.autoXLim;
-  if (ydata.isEmpty() || viewLen_ <= 0) {
+  const bool sourcedLine = deriveAudioX && isSourcedLine(data, scene.paged, line);
+  if ((ydata.isEmpty() && !sourcedLine) || viewLen <= 0) {
     return;
   }
   if (!deriveAudioX && (xdata.isEmpty() || xdata.size() != ydata.size())) {
@@ -761,20 +1058,24 @@ void SignalGraphWindow::drawLine(QPainter& p, const QRect& area, const GraphicsA
   const double ymaxAxis = axes.ylim[1];
   const double xspan = std::max(1e-12, xmax - xmin);
   const double yspan = std::max(1e-12, ymaxAxis - yminAxis);
+  const XOrder* xorder = deriveAudioX ? nullptr : &lineXOrder(scene.lineXOrders, line);
 
   int from = -1;
   int to = -1;
   if (deriveAudioX) {
-    const int totalLen = ydata.size();
+    const int totalLen = sourcedLine ? scene.dataLength : ydata.size();
     if (manualAudioX) {
-      const double sampleRate = static_cast<double>(data_.sampleRate);
-      const double t0 = data_.startTimeSec;
+      const double sampleRate = static_cast<double>(data.sampleRate);
+      const double t0 = data.startTimeSec;
       from = std::clamp(static_cast<int>(std::floor((xmin - t0) * sampleRate)), 0, std::max(0, totalLen - 1));
       to = std::clamp(static_cast<int>(std::ceil((xmax - t0) * sampleRate)) + 1, from + 1, totalLen);
     } else {
-      from = std::clamp(viewStart_, 0, std::max(0, totalLen - 1));
-      to = std::clamp(viewStart_ + viewLen_, from + 1, totalLen);
+      from = std::clamp(viewStart, 0, std::max(0, totalLen - 1));
+      to = std::clamp(viewStart + viewLen, from + 1, totalLen);
     }
+  } else if (xorder->sorted) {
+    from = static_cast<int>(std::lower_bound(xdata.begin(), xdata.end(), xmin) - xdata.begin());
+    to = static_cast<int>(std::upper_bound(xdata.begin(), xdata.end(), xmax) - xdata.begin());
   } else {
     for (int i = 0; i < xdata.size(); ++i) {
       if (xdata[i] >= xmin && xdata[i] <= xmax) {
@@ -796,12 +1097,24 @@ void SignalGraphWindow::drawLine(QPainter& p, const QRect& area, const GraphicsA
 
   const int width = std::max(1, area.width());
   const double samplesPerPixel = static_cast<double>(to - from) / width;
-  if (samplesPerPixel <= 1.0 && pen.style() != Qt::NoPen) {
+  const bool rawSamples = !(sourcedLine && scene.paged) || (scene.page && scene.page->blockSize == 1);
+  const MinMaxPyramid* pyramid = (deriveAudioX && !sourcedLine) ? linePyramid(scene.lineLods, line) : nullptr;
+  const int firstColumn = std::max(0, columnFrom);
+  const int lastColumn = std::min(width, columnTo);
+  if (samplesPerPixel <= 1.0 && rawSamples && pen.style() != Qt::NoPen) {
+    int first = from;
+    int last = to;
+    if (deriveAudioX && !manualAudioX && (firstColumn > 0 || lastColumn < width)) {
+      // One sample beyond each end of the columns so the path joins its neighbors.
+      const double total = std::max(1, viewLen - 1);
+      first = std::clamp(viewStart + static_cast<int>(std::floor((firstColumn - 1) * total / width)), from, to);
+      last = std::clamp(viewStart + static_cast<int>(std::ceil((lastColumn + 1) * total / width)) + 1, first, to);
+    }
     QPainterPath path;
     bool segmentOpen = false;
     QVector<QPointF> markerPoints;
-    for (int i = from; i < to; ++i) {
-      const double y = ydata[i];
+    for (int i = first; i < last; ++i) {
+      const double y = sourcedLine ? sourceSample(data, scene.paged, scene.page.get(), line.logicalChannel, i) : ydata[i];
       if (!std::isfinite(y)) {
         segmentOpen = false;
         continue;
@@ -810,11 +1123,11 @@ void SignalGraphWindow::drawLine(QPainter& p, const QRect& area, const GraphicsA
       double px = 0.0;
       if (deriveAudioX) {
         if (manualAudioX) {
-          const double t = data_.startTimeSec + static_cast<double>(i) / static_cast<double>(data_.sampleRate);
+          const double t = data.startTimeSec + static_cast<double>(i) / static_cast<double>(data.sampleRate);
           const double xNorm = (t - xmin) / xspan;
           px = area.left() + xNorm * area.width();
         } else {
-          px = sampleToX(area, i);
+          px = viewSampleToX(area, i, viewStart, viewLen);
         }
       } else {
         const double xNorm = (xdata[i] - xmin) / xspan;
@@ -842,8 +1155,31 @@ void SignalGraphWindow::drawLine(QPainter& p, const QRect& area, const GraphicsA
     return;
   }
 
+  // Bins of explicit xdata are found by binary search over its x order. Bins advance
+  // left to right, so each search starts where the previous bin began.
+  const int keyCount = xorder ? (xorder->sorted ? static_cast<int>(xdata.size()) : static_cast<int>(xorder->order.size())) : 0;
+  const auto keyIndex = [xorder](int k) { return xorder->sorted ? k : xorder->order[static_cast<size_t>(k)]; };
+  // First key at or after `lo` whose x is >= v (> v when `upper`).
+  const auto keyBound = [&](int lo, double v, bool upper) {
+    int hi = keyCount;
+    while (lo < hi) {
+      const int mid = lo + (hi - lo) / 2;
+      const double xv = xdata[keyIndex(mid)];
+      if (xv < v || (upper && xv == v)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  };
+  int keyCursor = 0;
+
   QVector<QPointF> markerPoints;
-  for (int x = 0; x < width; ++x) {
+  for (int x = firstColumn; x < lastColumn; ++x) {
+    if ((x & 0xff) == 0 && scene.cancelled()) {
+      return;
+    }
     double vmin = std::numeric_limits<double>::max();
     double vmax = std::numeric_limits<double>::lowest();
     bool any = false;
@@ -851,11 +1187,11 @@ void SignalGraphWindow::drawLine(QPainter& p, const QRect& area, const GraphicsA
       int s0 = from;
       int s1 = to;
       if (manualAudioX) {
-        const double sampleRate = static_cast<double>(data_.sampleRate);
+        const double sampleRate = static_cast<double>(data.sampleRate);
         const double binStart = xmin + (xspan * x) / width;
         const double binEnd = xmin + (xspan * (x + 1)) / width;
-        const double sampleStart = (binStart - data_.startTimeSec) * sampleRate;
-        const double sampleEnd = (binEnd - data_.startTimeSec) * sampleRate;
+        const double sampleStart = (binStart - data.startTimeSec) * sampleRate;
+        const double sampleEnd = (binEnd - data.startTimeSec) * sampleRate;
         if (sampleEnd <= from || sampleStart >= to) {
           continue;
         }
@@ -864,13 +1200,19 @@ void SignalGraphWindow::drawLine(QPainter& p, const QRect& area, const GraphicsA
         s0 = std::clamp(binStartSample, from, to - 1);
         s1 = std::clamp(binEndSample, s0 + 1, to);
       } else {
-        const int total = std::max(1, viewLen_ - 1);
-        const int binStartSample = viewStart_ + static_cast<int>(std::floor((static_cast<double>(x) * total) / width));
-        const int binEndSample = viewStart_ + static_cast<int>(std::ceil((static_cast<double>(x + 1) * total) / width));
+        const int total = std::max(1, viewLen - 1);
+        const int binStartSample = viewStart + static_cast<int>(std::floor((static_cast<double>(x) * total) / width));
+        const int binEndSample = viewStart + static_cast<int>(std::ceil((static_cast<double>(x + 1) * total) / width));
         s0 = std::clamp(binStartSample, from, to - 1);
         s1 = std::clamp(std::max(s0 + 1, binEndSample), s0 + 1, to);
       }
-      for (int i = s0; i < s1; ++i) {
+      if (sourcedLine) {
+        any = sourceMinMax(data, scene.paged, scene.page.get(), scene.channelLods, line.logicalChannel, s0, s1, vmin, vmax);
+      } else if (pyramid) {
+        pyramidMinMax(*pyramid, ydata.constData(), static_cast<size_t>(s0), static_cast<size_t>(s1), vmin, vmax);
+        any = vmin <= vmax;
+      }
+      for (int i = s0; i < s1 && !sourcedLine && !pyramid; ++i) {
         const double v = ydata[i];
         if (!std::isfinite(v)) {
           continue;
@@ -882,11 +1224,11 @@ void SignalGraphWindow::drawLine(QPainter& p, const QRect& area, const GraphicsA
     } else {
       const double binStart = xmin + (xspan * x) / width;
       const double binEnd = xmin + (xspan * (x + 1)) / width;
-      for (int i = from; i < to; ++i) {
-        if (xdata[i] < binStart || xdata[i] > binEnd) {
-          continue;
-        }
-        const double v = ydata[i];
+      const int k0 = keyBound(keyCursor, binStart, false);
+      const int k1 = keyBound(k0, binEnd, true);
+      keyCursor = k0;
+      for (int k = k0; k < k1; ++k) {
+        const double v = ydata[keyIndex(k)];
         if (!std::isfinite(v)) {
           continue;
         }
@@ -941,7 +1283,7 @@ void SignalGraphWindow::zoomIn() {
   if (data_.channels.empty()) {
     return;
   }
-  const int totalLen = totalTimelineSamples(data_);
+  const int totalLen = timelineLength();
   if (totalLen <= 1) {
     return;
   }
@@ -959,7 +1301,7 @@ void SignalGraphWindow::zoomOut() {
   if (data_.channels.empty()) {
     return;
   }
-  const int totalLen = totalTimelineSamples(data_);
+  const int totalLen = timelineLength();
   const int nextLen = std::min(totalLen, static_cast<int>(viewLen_ * 1.8));
   const int nextStart = std::clamp(viewStart_, 0, std::max(0, totalLen - nextLen));
   applyRange({nextStart, nextStart + nextLen});
@@ -970,7 +1312,7 @@ void SignalGraphWindow::panView(int direction) {
     return;
   }
 
-  const int totalLen = totalTimelineSamples(data_);
+  const int totalLen = timelineLength();
   const int currentLen = std::clamp(viewLen_, 1, std::max(1, totalLen));
   if (totalLen <= currentLen) {
     return;  // Full view: no panning room.
@@ -1004,15 +1346,24 @@ void SignalGraphWindow::stopPlayback() {
     audioSink_->deleteLater();
     audioSink_ = nullptr;
   }
-  if (audioBuffer_) {
-    audioBuffer_->close();
-    audioBuffer_->deleteLater();
-    audioBuffer_ = nullptr;
+  if (audioSource_) {
+    audioSource_->close();
+    audioSource_->deleteLater();
+    audioSource_ = nullptr;
   }
-  pcmData_.clear();
   update();
 }
 
+void SignalGraphWindow::showPlaybackError() {
+  stopPlayback();
+  playbackError_ = "Playback stopped: the engine is busy and could not supply the audio.";
+  update();
+  QTimer::singleShot(kPlaybackErrorMs, this, [this]() {
+    playbackError_.clear();
+    update();
+  });
+}
+
 void SignalGraphWindow::startPlaybackForRange(const Range& range) {
   startPlaybackFromSample(range, range.start, false);
 }
@@ -1025,8 +1376,8 @@ void SignalGraphWindow::startPlaybackFromSample(const Range& range, int startSam
   stopPlayback();
 
   const int offset = timelineOffsetSamples(data_);
-  const int dataLen = static_cast<int>(data_.channels.front().samples.size());
-  const int totalTimeline = totalTimelineSamples(data_);
+  const int dataLen = dataLength();
+  const int totalTimeline = timelineLength();
   if (dataLen <= 0 || totalTimeline <= 0) {
     return;
   }
@@ -1043,26 +1394,30 @@ void SignalGraphWindow::startPlaybackFromSample(const Range& range, int startSam
   fmt.setChannelCount(static_cast<int>(std::min<size_t>(2, data_.channels.size())));
   fmt.setSampleFormat(QAudioFormat::Int16);
 
-  const int chCount = fmt.channelCount();
-  const int frames = endTimeline - startTimeline;
-  pcmData_.resize(frames * chCount * static_cast<int>(sizeof(qint16)));
-
-  auto* out = reinterpret_cast<qint16*>(pcmData_.data());
-  for (int ti = startTimeline; ti < endTimeline; ++ti) {
-    const int di = ti - offset;
-    for (int c = 0; c < chCount; ++c) {
-      const auto& src = data_.channels[static_cast<size_t>(c)].samples;
-      double v = 0.0;
-      if (di >= 0 && di < static_cast<int>(src.size())) {
-        v = std::clamp(src[static_cast<size_t>(di)], -1.0, 1.0);
-      }
-      *out++ = static_cast<qint16>(std::lrint(v * 32767.0));
-    }
+  // Samples are converted as the sink pulls them. The source holds its own copy of
+  // data_ (sharing the sample buffers), so later updates to the window do not race it.
+  SignalPcmSource::Fetcher fetch;
+  int prefetchFrames = 0;
+  if (isPaged()) {
+    fetch = [provider = pageProvider_](int channel, int start, int length) { return provider(channel, start, length, 1); };
+    prefetchFrames = data_.sampleRate * kPlaybackPrefetchSeconds;
+  } else {
+    fetch = [data = data_](int channel, int start, int length) {
+      return copyChannelWindow(data.channels[static_cast<size_t>(channel)], start, length);
+    };
+  }
+  const int rangeStart = std::clamp(range.start, 0, startTimeline);
+  playbackError_.clear();
+  audioSource_ = new SignalPcmSource(fmt.channelCount(), offset, dataLen, rangeStart, endTimeline, std::move(fetch),
+                                     prefetchFrames, this);
+  audioSource_->open(QIODevice::ReadOnly);
+  audioSource_->seekToSample(startTimeline);
+  if (!audioSource_->prefetch()) {
+    showPlaybackError();
+    return;
   }
-
-  audioBuffer_ = new QBuffer(this);
-  audioBuffer_->setData(pcmData_);
-  audioBuffer_->open(QIODevice::ReadOnly);
+  // Called from readData; stopping the sink from inside its own read is left to the event loop.
+  audioSource_->onStarved = [this]() { QMetaObject::invokeMethod(this, [this]() { showPlaybackError(); }, Qt::QueuedConnection); };
 
   audioSink_ = new QAudioSink(fmt, this);
   connect(audioSink_, &QAudioSink::stateChanged, this, [this](QAudio::State st) {
@@ -1079,7 +1434,7 @@ void SignalGraphWindow::startPlaybackFromSample(const Range& range, int startSam
   });
 
   playheadTimer_.start();
-  audioSink_->start(audioBuffer_);
+  audioSink_->start(audioSource_);
   if (startPaused && audioSink_) {
     audioSink_->suspend();
   }
@@ -1179,7 +1534,7 @@ void SignalGraphWindow::syncFigurePosFromWidget() {
 
 void SignalGraphWindow::updateYRange() {
   if (data_.isAudio) {
-    if (data_.channels.empty() || data_.channels.front().samples.empty()) {
+    if (data_.channels.empty() || channelLength(data_.channels.front()) == 0) {
       yMin_ = -1.0;
       yMax_ = 1.0;
       return;
@@ -1199,6 +1554,17 @@ void SignalGraphWindow::updateYRange() {
     const int totalLen = line.ydata.size();
     const int from = std::clamp(viewStart_, 0, std::max(0, totalLen - 1));
     const int end = std::clamp(viewStart_ + viewLen_, from + 1, totalLen);
+    if (const auto* pyramid = linePyramid(lineLods_, line)) {
+      double vmin = std::numeric_limits<double>::infinity();
+      double vmax = -std::numeric_limits<double>::infinity();
+      pyramidMinMax(*pyramid, line.ydata.constData(), static_cast<size_t>(from), static_cast<size_t>(end), vmin, vmax);
+      if (vmin <= vmax) {
+        yMin_ = std::min(yMin_, vmin);
+        yMax_ = std::max(yMax_, vmax);
+        any = true;
+      }
+      continue;
+    }
     for (int i = from; i < end; ++i) {
       const double v = line.ydata[i];
       yMin_ = std::min(yMin_, v);
@@ -1258,53 +1624,382 @@ void SignalGraphWindow::syncVisibleXRangeToAxes() {
   }
 }
 
+int SignalGraphWindow::dataLength() const {
+  if (isPaged()) {
+    return pagedDataLen_;
+  }
+  return data_.channels.empty() ? 0 : channelLength(data_.channels.front());
+}
+
+int SignalGraphWindow::timelineLength() const {
+  if (data_.channels.empty()) {
+    return 0;
+  }
+  return timelineOffsetSamples(data_) + dataLength();
+}
+
+void SignalGraphWindow::ensurePage() {
+  if (!isPaged() || data_.channels.empty() || pagedDataLen_ <= 0) {
+    return;
+  }
+
+  // Line drawing indexes samples by view position, so the page is keyed on the view.
+  const int visStart = std::clamp(viewStart_, 0, pagedDataLen_ - 1);
+  const int visEnd = std::clamp(viewStart_ + std::max(1, viewLen_), visStart + 1, pagedDataLen_);
+  const long long visLen = visEnd - visStart;
+
+  // Raw samples when the visible range plus a neighbor on each side fits the budget,
+  // otherwise min/max pairs over the smallest power-of-two block that does.
+  int blockSize = 1;
+  if (visLen * 3 > kPageBudgetSamples) {
+    blockSize = 2;
+    while (visLen * 3 * 2 / blockSize > kPageBudgetSamples) {
+      blockSize *= 2;
+    }
+  }
+  if (page_ && page_->dataSerial == dataSerial_ && page_->blockSize == blockSize && page_->length > 0 &&
+      page_->start <= visStart && page_->start + page_->length >= visEnd) {
+    return;
+  }
+
+  int start = static_cast<int>(std::max(0LL, visStart - visLen));
+  const int end = static_cast<int>(std::min<long long>(pagedDataLen_, visEnd + visLen));
+  start -= start % blockSize;
+
+  auto page = std::make_shared<SamplePage>();
+  page->start = start;
+  page->length = end - start;
+  page->blockSize = blockSize;
+  page->dataSerial = dataSerial_;
+  for (int c = 0; c < static_cast<int>(data_.channels.size()); ++c) {
+    page->channels.push_back(pageProvider_(c, page->start, page->length, blockSize));
+    if (page->channels.back().empty()) {
+      // Engine unavailable (busy or variable gone); retry on the next rebuild.
+      page->length = 0;
+    }
+  }
+  // Replaced rather than modified: a render in flight may still hold the old page.
+  page_ = std::move(page);
+}
+
+bool SignalGraphWindow::pageMinMax(const SamplePage* page, int channel, int from, int to, double& vmin, double& vmax) {
+  if (!page || channel < 0 || channel >= static_cast<int>(page->channels.size()) || page->length <= 0) {
+    return false;
+  }
+  const auto& src = page->channels[static_cast<size_t>(channel)];
+  const int bs = page->blockSize;
+  const int first = std::max(0, (from - page->start) / bs);
+  const int last = std::min(static_cast<int>(src.size()) / (bs == 1 ? 1 : 2), (to - page->start + bs - 1) / bs);
+  if (last <= first) {
+    return false;
+  }
+  double lo = vmin;
+  double hi = vmax;
+  if (bs == 1) {
+    accumulateMinMax(src.data() + first, static_cast<size_t>(last - first), lo, hi);
+  } else {
+    accumulateMinMax(src.data() + 2 * first, static_cast<size_t>(last - first) * 2, lo, hi);
+  }
+  if (lo > hi) {
+    return false;
+  }
+  vmin = lo;
+  vmax = hi;
+  return true;
+}
+
+double SignalGraphWindow::pageSample(const SamplePage* page, int channel, int index) {
+  const double gap = std::numeric_limits<double>::quiet_NaN();
+  if (!page || channel < 0 || channel >= static_cast<int>(page->channels.size()) || page->length <= 0) {
+    return gap;
+  }
+  const auto& src = page->channels[static_cast<size_t>(channel)];
+  const int rel = index - page->start;
+  if (rel < 0 || rel >= page->length) {
+    return gap;
+  }
+  if (page->blockSize == 1) {
+    return rel < static_cast<int>(src.size()) ? src[static_cast<size_t>(rel)] : gap;
+  }
+  // Envelope page: report the block's midpoint.
+  const size_t pair = static_cast<size_t>(rel / page->blockSize) * 2;
+  return pair + 1 < src.size() ? 0.5 * (src[pair] + src[pair + 1]) : gap;
+}
+
+bool SignalGraphWindow::isSourcedLine(const SignalData& data, bool paged, const GraphicsLineHandle& line) {
+  // Signal lines of a paged window or over a sparse channel carry no ydata; their
+  // samples come from the page or the SignalData instead.
+  if (!line.ydata.isEmpty()) {
+    return false;
+  }
+  if (paged) {
+    return true;
+  }
+  const int channel = line.logicalChannel;
+  return channel >= 0 && channel < static_cast<int>(data.channels.size()) &&
+         data.channels[static_cast<size_t>(channel)].sparse;
+}
+
+double SignalGraphWindow::sourceSample(const SignalData& data, bool paged, const SamplePage* page, int channel, int index) {
+  if (paged) {
+    return pageSample(page, channel, index);
+  }
+  if (channel < 0 || channel >= static_cast<int>(data.channels.size())) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return channelSample(data.channels[static_cast<size_t>(channel)], index, std::numeric_limits<double>::quiet_NaN());
+}
+
+bool SignalGraphWindow::sourceMinMax(const SignalData& data,
+                                     bool paged,
+                                     const SamplePage* page,
+                                     std::vector<SampleLod>& channelLods,
+                                     int channel,
+                                     int from,
+                                     int to,
+                                     double& vmin,
+                                     double& vmax) {
+  if (paged) {
+    return pageMinMax(page, channel, from, to, vmin, vmax);
+  }
+  if (channel < 0 || channel >= static_cast<int>(data.channels.size())) {
+    return false;
+  }
+  const ChannelData& ch = data.channels[static_cast<size_t>(channel)];
+  const MinMaxPyramid* pyramid = nullptr;
+  if (static_cast<int>(ch.samples.size()) >= kLodMinSamples && channel < static_cast<int>(channelLods.size())) {
+    pyramid = refreshLod(channelLods[static_cast<size_t>(channel)], ch.samples.data(), static_cast<int>(ch.samples.size()));
+  }
+  double lo = vmin;
+  double hi = vmax;
+  forEachChannelRun(ch, from, to, [&](int, const double* samples, int count) {
+    if (pyramid) {
+      const size_t stored = static_cast<size_t>(samples - ch.samples.data());
+      pyramidMinMax(*pyramid, ch.samples.data(), stored, stored + static_cast<size_t>(count), lo, hi);
+    } else {
+      accumulateMinMax(samples, static_cast<size_t>(count), lo, hi);
+    }
+  });
+  if (lo > hi) {
+    return false;
+  }
+  vmin = lo;
+  vmax = hi;
+  return true;
+}
+
+const MinMaxPyramid* SignalGraphWindow::refreshLod(SampleLod& lod, const double* samples, int count) {
+  if (!lod.pyramid || lod.samples != samples || lod.count != count) {
+    lod.samples = samples;
+    lod.count = count;
+    lod.pyramid = std::make_shared<const MinMaxPyramid>(buildMinMaxPyramid(samples, static_cast<size_t>(count)));
+  }
+  return lod.pyramid.get();
+}
+
+const MinMaxPyramid* SignalGraphWindow::linePyramid(std::unordered_map<std::uint64_t, SampleLod>& lods,
+                                                    const GraphicsLineHandle& line) {
+  const int count = static_cast<int>(line.ydata.size());
+  if (count < kLodMinSamples) {
+    return nullptr;
+  }
+  return refreshLod(lods[line.common.id], line.ydata.constData(), count);
+}
+
+const XOrder& SignalGraphWindow::lineXOrder(std::unordered_map<std::uint64_t, LineXOrder>& orders,
+                                           const GraphicsLineHandle& line) {
+  LineXOrder& entry = orders[line.common.id];
+  const int count = static_cast<int>(line.xdata.size());
+  if (!entry.order || entry.xdata != line.xdata.constData() || entry.count != count) {
+    entry.xdata = line.xdata.constData();
+    entry.count = count;
+    entry.order = std::make_shared<const XOrder>(buildXOrder(line.xdata.constData(), static_cast<size_t>(count)));
+  }
+  return *entry.order;
+}
+
 void SignalGraphWindow::invalidateStaticLayer() {
-  staticLayerValid_ = false;
+  ++layerSerial_;
 }
 
 int SignalGraphWindow::sampleToX(const QRect& plot, int sample) const {
-  const int total = std::max(1, viewLen_ - 1);
-  const double frac = std::clamp((sample - viewStart_) / static_cast<double>(total), 0.0, 1.0);
-  return plot.left() + static_cast<int>(std::llround(frac * plot.width()));
+  return viewSampleToX(plot, sample, viewStart_, viewLen_);
+}
+
+SignalGraphWindow::LayerKey SignalGraphWindow::currentLayerKey(const QRect& plot) const {
+  LayerKey key;
+  key.size = size();
+  key.plot = plot;
+  key.dataSerial = dataSerial_;
+  key.layerSerial = layerSerial_;
+  key.viewStart = viewStart_;
+  key.viewLen = viewLen_;
+  key.yMin = yMin_;
+  key.yMax = yMax_;
+  key.stereoMode = graphics_.stereoDisplayMode();
+  key.workspaceActive = workspaceActive_;
+  return key;
 }
 
 void SignalGraphWindow::ensureStaticLayer(const QRect& plot) {
-  const bool needsRebuild = !staticLayerValid_ ||
-                            staticLayer_.size() != size() ||
-                            cachedDataSerial_ != dataSerial_ ||
-                            cachedViewStart_ != viewStart_ ||
-                            cachedViewLen_ != viewLen_ ||
-                            std::fabs(cachedYMin_ - yMin_) > 1e-12 ||
-                            std::fabs(cachedYMax_ - yMax_) > 1e-12 ||
-                            cachedStereoDisplayMode_ != graphics_.stereoDisplayMode() ||
-                            cachedWorkspaceActive_ != workspaceActive_ ||
-                            staticPlotRect_ != plot;
-  if (!needsRebuild) {
+  const LayerKey key = currentLayerKey(plot);
+  if ((!staticLayer_.isNull() && staticLayerKey_ == key) || (pendingLayerKey_ && *pendingLayerKey_ == key)) {
     return;
   }
 
-  staticLayer_ = QImage(size(), QImage::Format_ARGB32_Premultiplied);
-  staticLayer_.fill(graphics_.figure().common.color);
-  QPainter p(&staticLayer_);
+  // Page fetches go through the engine, so they stay on the GUI thread.
+  ensurePage();
+  auto scene = std::make_shared<LayerScene>(graphics_);
+  scene->key = key;
+  scene->data = data_;
+  scene->paged = isPaged();
+  scene->page = page_;
+  scene->dataLength = dataLength();
+  scene->lineLods = lineLods_;
+  scene->lineXOrders = lineXOrders_;
+  scene->channelLods = channelLods_;
+  scene->scrollColumns = staticLayerScrollColumns(key, scene->traceDrift);
+  if (scene->scrollColumns != 0) {
+    scene->previousTraces = staticTraces_;
+  }
+  scene->generation = ++renderGeneration_;
+  scene->latestGeneration = &renderGeneration_;
+
+  if (staticLayer_.isNull()) {
+    // Nothing to stand in for the first frame; render it here.
+    QImage image;
+    renderStaticLayer(*scene, image);
+    adoptStaticLayer(*scene, image);
+    return;
+  }
 
-  if (!workspaceActive_) {
+  pendingLayerKey_ = key;
+  renderPool_.start([this, scene]() {
+    QImage image;
+    if (!renderStaticLayer(*scene, image)) {
+      return;
+    }
+    QMetaObject::invokeMethod(
+        this,
+        [this, scene, image]() {
+          if (!scene->cancelled()) {
+            adoptStaticLayer(*scene, image);
+          }
+        },
+        Qt::QueuedConnection);
+  });
+}
+
+int SignalGraphWindow::staticLayerScrollColumns(const LayerKey& key, double& drift) const {
+  if (staticLayer_.isNull() || staticTraces_.empty() || !data_.isAudio || data_.sampleRate <= 0 || key.viewLen <= 1) {
+    return 0;
+  }
+  // Only a pan qualifies: everything but the view start must match the last frame.
+  LayerKey panned = staticLayerKey_;
+  panned.viewStart = key.viewStart;
+  const int shift = key.viewStart - staticLayerKey_.viewStart;
+  if (shift == 0 || panned != key) {
+    return 0;
+  }
+
+  // Every trace must be placed by sample index (auto x-limits, no xdata), with one
+  // column width shared by all axes so the whole figure shifts alike. Markers and
+  // dash patterns are laid out relative to the drawn range and would not line up.
+  int width = -1;
+  for (const auto& axes : graphics_.axes()) {
+    if (!axes.common.visible) {
+      continue;
+    }
+    const int axesWidth = axesRectForPlot(axes, key.plot).width();
+    if (!axes.autoXLim || (width >= 0 && axesWidth != width)) {
+      return 0;
+    }
+    width = axesWidth;
+  }
+  if (width <= 0) {
+    return 0;
+  }
+  for (const auto& line : graphics_.lines()) {
+    const Qt::PenStyle style = penStyleForLine(line.lineStyle);
+    if (!line.xdata.isEmpty() || hasMarker(line.marker) || (style != Qt::SolidLine && style != Qt::NoPen)) {
+      return 0;
+    }
+  }
+
+  // Columns move by a whole number; re-render once the rounding error adds up to
+  // half a column.
+  const double exact = static_cast<double>(shift) * width / (key.viewLen - 1);
+  const int columns = static_cast<int>(std::lround(exact));
+  const double nextDrift = staticTraceDrift_ + (exact - columns);
+  if (columns == 0 || std::abs(columns) >= width || std::fabs(nextDrift) > 0.5) {
+    return 0;
+  }
+  drift = nextDrift;
+  return columns;
+}
+
+QImage SignalGraphWindow::renderAxesTraces(LayerScene& scene, const GraphicsAxesHandle& axes, const QRect& axesRect) {
+  QImage traces(scene.key.size, QImage::Format_ARGB32_Premultiplied);
+  traces.fill(Qt::transparent);
+  QPainter p(&traces);
+
+  const int width = std::max(1, axesRect.width());
+  int columnFrom = 0;
+  int columnTo = width;
+  const auto previous = std::find_if(scene.previousTraces.begin(), scene.previousTraces.end(), [&axes](const AxesTraces& t) {
+    return t.axesId == axes.common.id;
+  });
+  if (scene.scrollColumns != 0 && previous != scene.previousTraces.end()) {
+    const QRect band(axesRect.left(), 0, width, traces.height());
+    p.setClipRect(band);
+    p.drawImage(QPoint(-scene.scrollColumns, 0), previous->image);
+    if (scene.scrollColumns > 0) {
+      columnFrom = width - scene.scrollColumns;
+    } else {
+      columnTo = -scene.scrollColumns;
+    }
+    p.setClipRect(QRect(axesRect.left() + columnFrom, 0, columnTo - columnFrom, traces.height()));
+  }
+  for (const auto* line : scene.graphics.linesForAxes(axes.common.id)) {
+    drawLine(scene, p, axesRect, axes, *line, columnFrom, columnTo);
+    if (scene.cancelled()) {
+      break;
+    }
+  }
+  return traces;
+}
+
+bool SignalGraphWindow::renderStaticLayer(LayerScene& scene, QImage& image) {
+  // renderPool_ also runs spectrum jobs, so it is never cleared; frames superseded
+  // while queued stop here.
+  if (scene.cancelled()) {
+    return false;
+  }
+  const GraphicsFigureModel& graphics = scene.graphics;
+  const SignalData& data = scene.data;
+  const QRect plot = scene.key.plot;
+  image = QImage(scene.key.size, QImage::Format_ARGB32_Premultiplied);
+  image.fill(graphics.figure().common.color);
+  QPainter p(&image);
+
+  if (!scene.key.workspaceActive) {
     p.setPen(Qt::NoPen);
     p.setBrush(QColor(0, 0, 0, 120));
     p.drawRect(plot);
     p.setPen(Qt::white);
     p.drawText(plot, Qt::AlignCenter, "Inactive (different workspace scope)");
-  } else if (graphics_.lines().empty()) {
+  } else if (graphics.lines().empty()) {
     p.setPen(Qt::white);
     p.drawText(plot, Qt::AlignCenter, "No signal data");
   } else {
-    for (const auto& axes : graphics_.axes()) {
+    for (const auto& axes : graphics.axes()) {
       if (!axes.common.visible) {
         continue;
       }
       const QRect axesRect = axesRectForPlot(axes, plot);
       const int xTickCount = 7;
       const int yTickCount = 5;
-      const bool xIsTime = data_.isAudio && data_.sampleRate > 0;
+      const bool xIsTime = data.isAudio && data.sampleRate > 0;
       const double xStartVal = axes.xlim[0];
       const double xEndVal = axes.xlim[1];
       const double xSpan = std::max(1e-12, xEndVal - xStartVal);
@@ -1381,9 +2076,12 @@ void SignalGraphWindow::ensureStaticLayer(const QRect& plot) {
         p.setPen(QPen(QColor(40, 40, 40), std::max(1, axes.lineWidth)));
         p.drawRect(axesRect);
       }
-      for (const auto* line : graphics_.linesForAxes(axes.common.id)) {
-        drawLine(p, axesRect, axes, *line);
+      const QImage traces = renderAxesTraces(scene, axes, axesRect);
+      if (scene.cancelled()) {
+        return false;
       }
+      p.drawImage(QPoint(0, 0), traces);
+      scene.traces.push_back({axes.common.id, traces});
       p.setPen(QColor(36, 36, 36));
       for (double tick : xTicks) {
         const double frac = std::clamp((tick - xStartVal) / std::max(1e-12, xSpan), 0.0, 1.0);
@@ -1408,16 +2106,16 @@ void SignalGraphWindow::ensureStaticLayer(const QRect& plot) {
     }
 
     p.setPen(QColor(24, 24, 24));
-    for (const auto& text : graphics_.texts()) {
+    for (const auto& text : graphics.texts()) {
       if (!text.common.visible || text.stringValue.isEmpty()) {
         continue;
       }
       QRect parentRect = plot;
-      if (text.common.parentId != graphics_.figure().common.id) {
-        auto axIt = std::find_if(graphics_.axes().begin(), graphics_.axes().end(), [&text](const GraphicsAxesHandle& axes) {
+      if (text.common.parentId != graphics.figure().common.id) {
+        auto axIt = std::find_if(graphics.axes().begin(), graphics.axes().end(), [&text](const GraphicsAxesHandle& axes) {
           return axes.common.id == text.common.parentId;
         });
-        if (axIt == graphics_.axes().end() || !axIt->common.visible) {
+        if (axIt == graphics.axes().end() || !axIt->common.visible) {
           continue;
         }
         parentRect = axesRectForPlot(*axIt, plot);
@@ -1428,15 +2126,87 @@ void SignalGraphWindow::ensureStaticLayer(const QRect& plot) {
     }
   }
 
-  staticLayerValid_ = true;
-  staticPlotRect_ = plot;
-  cachedDataSerial_ = dataSerial_;
-  cachedViewStart_ = viewStart_;
-  cachedViewLen_ = viewLen_;
-  cachedYMin_ = yMin_;
-  cachedYMax_ = yMax_;
-  cachedStereoDisplayMode_ = graphics_.stereoDisplayMode();
-  cachedWorkspaceActive_ = workspaceActive_;
+  return true;
+}
+
+void SignalGraphWindow::adoptStaticLayer(const LayerScene& scene, const QImage& image) {
+  staticLayer_ = image;
+  staticLayerKey_ = scene.key;
+  staticTraces_ = scene.traces;
+  staticTraceDrift_ = scene.traceDrift;
+  if (pendingLayerKey_ && *pendingLayerKey_ == scene.key) {
+    pendingLayerKey_.reset();
+  }
+  // Keep the pyramids the render built, unless the lines or data moved on meanwhile.
+  if (scene.key.dataSerial == dataSerial_ && scene.key.layerSerial == layerSerial_) {
+    for (const auto& [id, lod] : scene.lineLods) {
+      const GraphicsLineHandle* line = graphics_.lineById(id);
+      if (line && lod.pyramid && lod.samples == line->ydata.constData() && lod.count == line->ydata.size()) {
+        lineLods_[id] = lod;
+      }
+    }
+    for (const auto& [id, order] : scene.lineXOrders) {
+      const GraphicsLineHandle* line = graphics_.lineById(id);
+      if (line && order.order && order.xdata == line->xdata.constData() && order.count == line->xdata.size()) {
+        lineXOrders_[id] = order;
+      }
+    }
+    if (scene.channelLods.size() == channelLods_.size()) {
+      channelLods_ = scene.channelLods;
+    }
+  }
+  update();
+}
+
+void SignalGraphWindow::drawStaticLayer(QPainter& p, const QRect& plot) {
+  if (staticLayer_.isNull()) {
+    return;
+  }
+  const LayerKey& key = staticLayerKey_;
+  if (key == currentLayerKey(plot)) {
+    p.drawImage(QPoint(0, 0), staticLayer_);
+    return;
+  }
+  if (key.size != size() || key.plot != plot) {
+    p.drawImage(rect(), staticLayer_);
+    return;
+  }
+
+  // Stand-in until the pending frame arrives: stretch the part of the old view that
+  // is still visible onto its new position in each axes.
+  p.drawImage(QPoint(0, 0), staticLayer_);
+  if (key.viewLen <= 0 || viewLen_ <= 0) {
+    return;
+  }
+  const int overlapStart = std::max(key.viewStart, viewStart_);
+  const int overlapEnd = std::min(key.viewStart + key.viewLen, viewStart_ + viewLen_) - 1;
+  for (const auto& axes : graphics_.axes()) {
+    if (!axes.common.visible) {
+      continue;
+    }
+    const QRect axesRect = axesRectForPlot(axes, plot);
+    p.fillRect(axesRect, axes.common.color);
+    if (overlapEnd <= overlapStart) {
+      continue;
+    }
+    const int srcLeft = viewSampleToX(axesRect, overlapStart, key.viewStart, key.viewLen);
+    const int srcRight = viewSampleToX(axesRect, overlapEnd, key.viewStart, key.viewLen);
+    const int dstLeft = viewSampleToX(axesRect, overlapStart, viewStart_, viewLen_);
+    const int dstRight = viewSampleToX(axesRect, overlapEnd, viewStart_, viewLen_);
+    if (srcRight <= srcLeft || dstRight <= dstLeft) {
+      continue;
+    }
+    const QRect src(srcLeft, axesRect.top(), srcRight - srcLeft, axesRect.height());
+    const QRect dst(dstLeft, axesRect.top(), dstRight - dstLeft, axesRect.height());
+    p.drawImage(dst, staticLayer_, src);
+  }
+}
+
+void SignalGraphWindow::cancelStaticLayerRender() {
+  ++renderGeneration_;
+  renderPool_.clear();
+  renderPool_.waitForDone();
+  pendingLayerKey_.reset();
 }
 
 QRect SignalGraphWindow::plotRect() const {
@@ -1496,7 +2266,7 @@ void SignalGraphWindow::updateHoverFromPoint(const QPoint& pt) {
   hoverXCoord_ = axes->xlim[0] + x01 * (axes->xlim[1] - axes->xlim[0]);
   if (data_.isAudio && data_.sampleRate > 0) {
     const double samplePos = (hoverXCoord_ - data_.startTimeSec) * static_cast<double>(data_.sampleRate);
-    hoverSample_ = std::clamp(static_cast<int>(std::llround(samplePos)), 0, std::max(0, totalTimelineSamples(data_) - 1));
+    hoverSample_ = std::clamp(static_cast<int>(std::llround(samplePos)), 0, std::max(0, timelineLength() - 1));
   } else {
     hoverSample_ = xToSample(pt);
   }
@@ -1506,7 +2276,9 @@ void SignalGraphWindow::updateHoverFromPoint(const QPoint& pt) {
     return;
   }
   const auto* line = lines.front();
-  if (line && hoverSample_ >= 0 && hoverSample_ < line->ydata.size()) {
+  if (line && isSourcedLine(data_, isPaged(), *line)) {
+    hoverValue_ = sourceSample(data_, isPaged(), page_.get(), line->logicalChannel, hoverSample_);
+  } else if (line && hoverSample_ >= 0 && hoverSample_ < line->ydata.size()) {
     hoverValue_ = line->ydata[hoverSample_];
   } else {
     hoverValue_ = std::numeric_limits<double>::quiet_NaN();
@@ -1542,7 +2314,105 @@ QString SignalGraphWindow::formatTimeValue(int sample, bool withSuffix) const {
   return QString::number(sample + 1);
 }
 
-QString SignalGraphWindow::formatRmsInfo(const Range& range) const {
+bool SignalGraphWindow::pagedEnergyReady(int firstBlock, int lastBlock) {
+  const int blocks = pagedDataLen_ / kPagedEnergyBlock;
+  if (pagedEnergySerial_ != dataSerial_) {
+    PagedEnergy empty;
+    empty.blocks.assign(static_cast<size_t>(blocks), 0.0);
+    empty.known.assign(static_cast<size_t>(blocks), 0);
+    pagedEnergy_.assign(data_.channels.size(), empty);
+    pagedEnergySerial_ = dataSerial_;
+  }
+  firstBlock = std::min(firstBlock, blocks);
+  lastBlock = std::clamp(lastBlock, firstBlock, blocks);
+  for (const PagedEnergy& energy : pagedEnergy_) {
+    const auto last = energy.known.begin() + lastBlock;
+    if (std::find(energy.known.begin() + firstBlock, last, 0) != last) {
+      pagedEnergyWanted_ = {firstBlock, lastBlock};
+      if (!pagedEnergyTimer_.isActive()) {
+        pagedEnergyTimer_.start();
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+void SignalGraphWindow::fillPagedEnergy() {
+  if (!isPaged() || pagedEnergySerial_ != dataSerial_) {
+    return;
+  }
+  // One slice per tick, so gathering a long range never stalls the GUI.
+  int budget = kPagedRmsChunkSamples / kPagedEnergyBlock;
+  for (int c = 0; c < static_cast<int>(pagedEnergy_.size()); ++c) {
+    PagedEnergy& energy = pagedEnergy_[static_cast<size_t>(c)];
+    int b = pagedEnergyWanted_.start;
+    while (b < pagedEnergyWanted_.end && budget > 0) {
+      if (energy.known[static_cast<size_t>(b)]) {
+        ++b;
+        continue;
+      }
+      int run = 1;
+      while (b + run < pagedEnergyWanted_.end && run < budget && !energy.known[static_cast<size_t>(b + run)]) {
+        ++run;
+      }
+      std::vector<double> chunk = pageProvider_(c, b * kPagedEnergyBlock, run * kPagedEnergyBlock, 1);
+      if (static_cast<int>(chunk.size()) < run * kPagedEnergyBlock) {
+        // The engine is busy; the next paint asks again.
+        return;
+      }
+      for (int k = 0; k < run; ++k) {
+        const size_t block = static_cast<size_t>(b + k);
+        energy.blocks[block] = finiteSumOfSquares(chunk, static_cast<size_t>(k) * kPagedEnergyBlock, kPagedEnergyBlock);
+        energy.known[block] = 1;
+      }
+      b += run;
+      budget -= run;
+    }
+  }
+  if (budget > 0) {
+    update();
+  } else {
+    pagedEnergyTimer_.start();
+  }
+}
+
+bool SignalGraphWindow::pagedRangeEnergy(int channel, int from, int to, double& sumSq) const {
+  sumSq = 0.0;
+  if (to <= from) {
+    return true;
+  }
+  // Block energies are added as an EnergySum so quiet ranges late in a loud signal
+  // keep their energy.
+  const PagedEnergy& energy = pagedEnergy_[static_cast<size_t>(channel)];
+  const int firstBlock = (from + kPagedEnergyBlock - 1) / kPagedEnergyBlock;
+  const int lastBlock = std::min(to / kPagedEnergyBlock, static_cast<int>(energy.blocks.size()));
+  EnergySum sum;
+  auto partial = [&](int a, int b) {
+    if (b <= a) {
+      return true;
+    }
+    std::vector<double> samples = pageProvider_(channel, a, b - a, 1);
+    if (static_cast<int>(samples.size()) < b - a) {
+      return false;
+    }
+    addEnergy(sum, finiteSumOfSquares(samples, 0, static_cast<size_t>(b - a)));
+    return true;
+  };
+  bool ok = true;
+  if (firstBlock >= lastBlock) {
+    ok = partial(from, to);
+  } else {
+    for (int b = firstBlock; b < lastBlock; ++b) {
+      addEnergy(sum, energy.blocks[static_cast<size_t>(b)]);
+    }
+    ok = partial(from, firstBlock * kPagedEnergyBlock) && partial(lastBlock * kPagedEnergyBlock, to);
+  }
+  sumSq = energyTotal(sum);
+  return ok;
+}
+
+QString SignalGraphWindow::formatRmsInfo(const Range& range) {
   if (!data_.isAudio) {
     return {};
   }
@@ -1550,31 +2420,69 @@ QString SignalGraphWindow::formatRmsInfo(const Range& range) const {
     return "[dBRMS] -";
   }
 
-  const int totalTimeline = std::max(1, totalTimelineSamples(data_));
+  const int totalTimeline = std::max(1, timelineLength());
   const int start = std::clamp(range.start, 0, totalTimeline - 1);
   const int end = std::clamp(range.end, start + 1, totalTimeline);
   const int offset = timelineOffsetSamples(data_);
 
+  if (isPaged()) {
+    // Answered from the blocked energy index; cached per range and data serial. When
+    // the engine cannot supply samples nothing is cached and the next paint retries.
+    if (pagedRmsSerial_ == dataSerial_ && pagedRmsRange_.start == start && pagedRmsRange_.end == end) {
+      return pagedRmsText_;
+    }
+    const int d0 = std::max(0, start - offset);
+    const int d1 = std::min(pagedDataLen_, end - offset);
+    const int firstBlock = (d0 + kPagedEnergyBlock - 1) / kPagedEnergyBlock;
+    if (!pagedEnergyReady(firstBlock, std::max(firstBlock, d1 / kPagedEnergyBlock))) {
+      return QString::fromUtf8("[dBRMS] \u2026");
+    }
+    QString text = "[dBRMS]";
+    for (int c = 0; c < static_cast<int>(data_.channels.size()); ++c) {
+      double sumSq = 0.0;
+      if (!pagedRangeEnergy(c, d0, d1, sumSq)) {
+        return "[dBRMS] -";
+      }
+      const double mean = d1 > d0 ? sumSq / static_cast<double>(d1 - d0) : 0.0;
+      text += mean > 0.0 ? QString(" %1").arg(20.0 * std::log10(std::sqrt(mean)) + kRmsDbOffset, 0, 'f', 1)
+                         : QString(" -inf");
+    }
+    pagedRmsRange_ = {start, end};
+    pagedRmsSerial_ = dataSerial_;
+    pagedRmsText_ = text;
+    return text;
+  }
+
+  if (channelEnergySerial_ != dataSerial_) {
+    channelEnergy_.clear();
+    for (const auto& ch : data_.channels) {
+      channelEnergy_.push_back(buildEnergyIndex(ch.samples.constData(), static_cast<size_t>(ch.samples.size())));
+    }
+    channelEnergySerial_ = dataSerial_;
+  }
+
   QString out = "[dBRMS]";
-  for (const auto& ch : data_.channels) {
+  for (size_t c = 0; c < data_.channels.size(); ++c) {
+    const ChannelData& ch = data_.channels[c];
     const int d0 = std::max(0, start - offset);
-    const int d1 = std::min(static_cast<int>(ch.samples.size()), end - offset);
+    const int d1 = std::min(channelLength(ch), end - offset);
     if (d1 <= d0) {
       out += " -inf";
       continue;
     }
 
-    long double sumSq = 0.0;
-    for (int i = d0; i < d1; ++i) {
-      const double v = ch.samples[static_cast<size_t>(i)];
-      sumSq += static_cast<long double>(v) * static_cast<long double>(v);
-    }
-    const long double mean = sumSq / static_cast<long double>(d1 - d0);
+    // Gaps of a sparse channel count as silence.
+    double sumSq = 0.0;
+    forEachChannelRun(ch, d0, d1, [&](int, const double* samples, int count) {
+      const size_t stored = static_cast<size_t>(samples - ch.samples.constData());
+      sumSq += rangeEnergy(channelEnergy_[c], ch.samples.constData(), stored, stored + static_cast<size_t>(count));
+    });
+    const double mean = sumSq / static_cast<double>(d1 - d0);
     if (mean <= 0.0) {
       out += " -inf";
       continue;
     }
-    const double rmsDb = 20.0 * std::log10(std::sqrt(static_cast<double>(mean))) + kRmsDbOffset;
+    const double rmsDb = 20.0 * std::log10(std::sqrt(mean)) + kRmsDbOffset;
     out += QString(" %1").arg(rmsDb, 0, 'f', 1);
   }
   return out;
@@ -1593,19 +2501,137 @@ void SignalGraphWindow::toggleFftOverlay() {
 }
 
 void SignalGraphWindow::ensureFftData() {
-  const bool stale = !fftComputed_ || fftViewStart_ != viewStart_ || fftViewLen_ != viewLen_ || fftDataSerial_ != dataSerial_;
+  const bool stale = fftViewStart_ != viewStart_ || fftViewLen_ != viewLen_ || fftDataSerial_ != dataSerial_;
   if (!stale) {
     return;
   }
-  fftComputed_ = true;
+  // Stops a job still working on the previous view.
+  ++fftGeneration_;
   fftViewStart_ = viewStart_;
   fftViewLen_ = viewLen_;
   fftDataSerial_ = dataSerial_;
+  fftDb_.assign(data_.channels.size(), std::vector<double>());
+  fftPendingChannels_.clear();
+  for (int ch = 0; ch < static_cast<int>(data_.channels.size()); ++ch) {
+    auto hit = std::find_if(fftCache_.begin(), fftCache_.end(), [this, ch](const FftCacheEntry& entry) {
+      return entry.dataSerial == dataSerial_ && entry.viewStart == viewStart_ && entry.viewLen == viewLen_ &&
+             entry.channel == ch;
+    });
+    if (hit != fftCache_.end()) {
+      hit->lastUse = ++fftCacheTick_;
+      fftDb_[static_cast<size_t>(ch)] = hit->db;
+    } else {
+      fftPendingChannels_.push_back(ch);
+    }
+  }
+  fftComputed_ = fftPendingChannels_.empty() || (isPaged() && !fftProvider_);
+  if (fftComputed_) {
+    fftComputeTimer_.stop();
+    return;
+  }
+  // Restarting the timer drops the request for the view it was waiting on.
+  fftComputeTimer_.start();
+}
+
+void SignalGraphWindow::setSpectrumOptions(const WelchOptions& options) {
+  spectrumOptions_ = options;
+  invalidateFftData();
+}
+
+void SignalGraphWindow::invalidateFftData() {
+  ++fftGeneration_;
+  fftCache_.clear();
+  fftComputed_ = false;
   fftDb_.clear();
-  if (!fftProvider_) {
+  fftPendingChannels_.clear();
+  fftViewStart_ = -1;
+  fftViewLen_ = -1;
+  fftDataSerial_ = -1;
+  if (showFftOverlay_) {
+    ensureFftData();
+    update();
+  }
+}
+
+void SignalGraphWindow::computePendingFft() {
+  if (fftComputed_ || fftPendingChannels_.empty()) {
+    return;
+  }
+  if (isPaged()) {
+    // Paged samples are read through the engine, which only this thread may use.
+    fftComputed_ = true;
+    const auto db = fftProvider_(fftViewStart_, fftViewLen_);
+    // An empty result means the engine was busy; leave it uncached so a later view retries.
+    if (db.empty()) {
+      fftDb_.clear();
+    }
+    for (int ch : fftPendingChannels_) {
+      if (ch < static_cast<int>(db.size()) && ch < static_cast<int>(fftDb_.size())) {
+        fftDb_[static_cast<size_t>(ch)] = db[static_cast<size_t>(ch)];
+        cacheFftChannel(ch, fftDb_[static_cast<size_t>(ch)]);
+      }
+    }
+    fftPendingChannels_.clear();
+    update();
+    return;
+  }
+
+  // The window holds its samples, so the missing channels are computed on renderPool_
+  // from a copy of the data (the channel buffers are shared, not duplicated).
+  const int dataLen = dataLength();
+  const int start = std::clamp(fftViewStart_ - timelineOffsetSamples(data_), 0, dataLen);
+  const int len = std::min(std::max(1, fftViewLen_), dataLen - start);
+  const WelchPlan plan = planWelchSegments(start, len, spectrumOptions_);
+  const SpectrumWindow window = spectrumOptions_.window;
+  const std::uint64_t generation = fftGeneration_.load();
+  renderPool_.start([this, data = data_, channels = fftPendingChannels_, plan, window, generation]() {
+    std::vector<std::vector<double>> db;
+    for (int ch : channels) {
+      if (plan.starts.empty() || ch >= static_cast<int>(data.channels.size())) {
+        db.emplace_back();
+        continue;
+      }
+      const ChannelData& channel = data.channels[static_cast<size_t>(ch)];
+      WelchSpectrum spectrum = makeWelchSpectrum(static_cast<size_t>(plan.segmentSize), window);
+      for (int segStart : plan.starts) {
+        if (fftGeneration_.load() != generation) {
+          return;
+        }
+        const std::vector<double> samples = copyChannelWindow(channel, segStart, plan.segmentSize);
+        addWelchSegment(spectrum, samples.data());
+      }
+      db.push_back(welchPowerDb(spectrum));
+    }
+    QMetaObject::invokeMethod(
+        this, [this, generation, channels, db]() { adoptFftChannels(generation, channels, db); }, Qt::QueuedConnection);
+  });
+}
+
+void SignalGraphWindow::adoptFftChannels(std::uint64_t generation,
+                                         const std::vector<int>& channels,
+                                         const std::vector<std::vector<double>>& db) {
+  if (generation != fftGeneration_.load() || fftComputed_) {
     return;
   }
-  fftDb_ = fftProvider_(viewStart_, viewLen_);
+  for (size_t i = 0; i < channels.size() && i < db.size(); ++i) {
+    const int ch = channels[i];
+    if (ch >= 0 && ch < static_cast<int>(fftDb_.size())) {
+      fftDb_[static_cast<size_t>(ch)] = db[i];
+      cacheFftChannel(ch, db[i]);
+    }
+  }
+  fftComputed_ = true;
+  fftPendingChannels_.clear();
+  update();
+}
+
+void SignalGraphWindow::cacheFftChannel(int channel, const std::vector<double>& db) {
+  if (fftCache_.size() >= kFftCacheEntries) {
+    fftCache_.erase(std::min_element(fftCache_.begin(), fftCache_.end(), [](const FftCacheEntry& a, const FftCacheEntry& b) {
+      return a.lastUse < b.lastUse;
+    }));
+  }
+  fftCache_.push_back({fftDataSerial_, fftViewStart_, fftViewLen_, channel, db, ++fftCacheTick_});
 }
 
 std::vector<SignalGraphWindow::FftPaneLayout> SignalGraphWindow::buildFftPaneLayouts(const QRect& plot, int nChannels) const {
@@ -1657,6 +2683,15 @@ void SignalGraphWindow::drawFftOverlays(QPainter& p, const QRect& plot) {
     return;
   }
   ensureFftData();
+  if (!fftComputed_) {
+    p.setPen(QColor(35, 35, 35));
+    for (const auto& pane : buildFftPaneLayouts(plot, static_cast<int>(data_.channels.size()))) {
+      p.fillRect(pane.box, QColor(238, 238, 228, 230));
+      p.drawRect(pane.box);
+      p.drawText(pane.box, Qt::AlignCenter, QString::fromUtf8("computing\u2026"));
+    }
+    return;
+  }
   if (fftDb_.empty()) {
     return;
   }
@@ -1692,10 +2727,8 @@ void SignalGraphWindow::drawFftOverlays(QPainter& p, const QRect& plot) {
     if (!db.empty()) {
       QPainterPath path;
       bool first = true;
-      const int n = static_cast<int>(db.size());
-      for (int i = 0; i < n; ++i) {
-        const double xf = (n <= 1) ? 0.0 : static_cast<double>(i) / (n - 1);
-        const double clampedDb = std::clamp(db[static_cast<size_t>(i)], -80.0, 0.0);
+      const auto addVertex = [&](double xf, double value) {
+        const double clampedDb = std::clamp(value, -80.0, 0.0);
         const double yf = (0.0 - clampedDb) / 80.0;
         const double px = inner.left() + xf * inner.width();
         const double py = inner.top() + yf * inner.height();
@@ -1705,6 +2738,23 @@ void SignalGraphWindow::drawFftOverlays(QPainter& p, const QRect& plot) {
         } else {
           path.lineTo(px, py);
         }
+      };
+      const int n = static_cast<int>(db.size());
+      const int columns = std::max(1, inner.width());
+      if (n <= 2 * columns) {
+        for (int i = 0; i < n; ++i) {
+          addVertex((n <= 1) ? 0.0 : static_cast<double>(i) / (n - 1), db[static_cast<size_t>(i)]);
+        }
+      } else {
+        // More bins than pixels: one min/max vertex pair per pixel column.
+        for (int x = 0; x < columns; ++x) {
+          const int b0 = static_cast<int>(static_cast<long long>(n) * x / columns);
+          const int b1 = std::max(b0 + 1, static_cast<int>(static_cast<long long>(n) * (x + 1) / columns));
+          const auto [lo, hi] = std::minmax_element(db.begin() + b0, db.begin() + b1);
+          const double xf = static_cast<double>(x) / std::max(1, columns - 1);
+          addVertex(xf, *lo);
+          addVertex(xf, *hi);
+        }
       }
       p.setRenderHint(QPainter::Antialiasing, true);
       p.setPen(QPen(chColors[ch % 2], 1.3));
@@ -1722,7 +2772,7 @@ void SignalGraphWindow::drawFftOverlays(QPainter& p, const QRect& plot) {
   }
 }
 
-void SignalGraphWindow::drawStatusBar(QPainter& p) const {
+void SignalGraphWindow::drawStatusBar(QPainter& p) {
   const QRect bar = rect().adjusted(0, rect().height() - 30, 0, 0);
   p.fillRect(bar, QColor(224, 224, 224));
   p.setPen(QColor(88, 88, 88));
@@ -1730,7 +2780,7 @@ void SignalGraphWindow::drawStatusBar(QPainter& p) const {
 
   const Range sel = normalizedSelection();
   const bool hasSel = sel.end > sel.start;
-  const int totalTimeline = std::max(1, totalTimelineSamples(data_));
+  const int totalTimeline = std::max(1, timelineLength());
   const Range rmsRange = hasSel ? sel : Range{0, totalTimeline};
 
   const QString mouseText =
@@ -1750,7 +2800,7 @@ void SignalGraphWindow::drawStatusBar(QPainter& p) const {
            : formatTimeValue(viewStart_ + std::max(1, viewLen_) - 1, true);
   const QString selStartText = hasSel ? formatTimeValue(sel.start, true) : QString();
   const QString selEndText = hasSel ? formatTimeValue(sel.end, true) : QString();
-  const QString rmsText = formatRmsInfo(rmsRange);
+  const QString rmsText = playbackError_.isEmpty() ? formatRmsInfo(rmsRange) : playbackError_;
 
   const QStringList cells = {mouseText, viewStartText, viewEndText, selStartText, selEndText, rmsText};
   const int widths[] = {160, 90, 90, 90, 90, std::max(240, width() - 520)};
@@ -1760,7 +2810,7 @@ void SignalGraphWindow::drawStatusBar(QPainter& p) const {
     const QRect c(x, bar.top() + 1, widths[i], bar.height() - 1);
     p.setPen(QColor(140, 140, 140));
     p.drawRect(c.adjusted(0, 0, -1, -1));
-    p.setPen(QColor(18, 18, 18));
+    p.setPen(i == 5 && !playbackError_.isEmpty() ? QColor(176, 0, 0) : QColor(18, 18, 18));
     p.drawText(c.adjusted(6, 0, -6, 0), Qt::AlignVCenter | Qt::AlignLeft, cells[i]);
     x += widths[i];
     if (x >= width()) {
@@ -2,15 +2,21 @@
 
 #include "AuxEngineFacade.h"
 #include "GraphicsObjects.h"
+#include "SignalKernels.h"
 
 #include <QAudioSink>
-#include <QBuffer>
 #include <QImage>
 #include <QMoveEvent>
 #include <optional>
+#include <QThreadPool>
 #include <QTimer>
 #include <QWidget>
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <unordered_map>
+
+class SignalPcmSource;
 
 class SignalGraphWindow : public QWidget {
   Q_OBJECT
@@ -26,6 +32,10 @@ public:
   };
 
   using FftProvider = std::function<std::vector<std::vector<double>>(int, int)>;
+  // Returns `length` raw samples of `channel` from `startSample` when blockSize is 1,
+  // otherwise interleaved (min, max) pairs per block of blockSize samples. An empty
+  // result means the engine cannot supply them right now (busy, or the variable is gone).
+  using SampleWindowProvider = std::function<std::vector<double>(int channel, int startSample, int length, int blockSize)>;
   struct FftPaneLayout {
     int channel = 0;
     QRect box;
@@ -43,6 +53,14 @@ public:
   QString varName() const;
   void setWorkspaceActive(bool active);
   void updateData(const SignalData& data);
+  void setPagedSource(const SignalInfo& info, SampleWindowProvider provider);
+  bool isPaged() const { return static_cast<bool>(pageProvider_); }
+  // ydata of a line as the handle API sees it. Lines over a sparse channel or in a
+  // paged window keep no copy, so their samples are read from the signal data or the
+  // page provider (gaps as NaN); nullopt when the provider cannot supply them. A
+  // positive maxCount limits the result to the first maxCount samples.
+  std::optional<QVector<double>> lineYData(std::uint64_t lineId, int maxCount = -1) const;
+  int lineSampleCount(std::uint64_t lineId) const;
   std::uint64_t addAxes(const std::array<double, 4>& pos);
   std::uint64_t addLine(std::uint64_t axesId, const QVector<double>& xdata, const QVector<double>& ydata);
   std::uint64_t addText(std::uint64_t parentId, double x, double y, const QString& text);
@@ -61,6 +79,9 @@ public:
   void refreshGraphics();
   void setAxesXLim(std::uint64_t axesId, const std::array<double, 2>& xlim);
   void setAxesYLim(std::uint64_t axesId, const std::array<double, 2>& ylim);
+  // Analysis settings of the FFT overlay for windows that hold their samples; paged
+  // windows get their spectra from the FftProvider. Drops cached spectra.
+  void setSpectrumOptions(const WelchOptions& options);
 
 protected:
   void paintEvent(QPaintEvent* event) override;
@@ -78,8 +99,92 @@ private:
     int end = 0;
   };
 
-  QRect axesRectForPlot(const GraphicsAxesHandle& axes, const QRect& plot) const;
-  void drawLine(QPainter& p, const QRect& area, const GraphicsAxesHandle& axes, const GraphicsLineHandle& line);
+  struct SamplePage {
+    int start = 0;
+    int length = 0;
+    int blockSize = 1;
+    int dataSerial = -1;
+    std::vector<std::vector<double>> channels;
+  };
+
+  // Min/max pyramid over a sample buffer; rebuilt when the buffer changes. Shared so a
+  // render snapshot can carry the window's pyramids and hand new ones back.
+  struct SampleLod {
+    const double* samples = nullptr;
+    int count = 0;
+    std::shared_ptr<const MinMaxPyramid> pyramid;
+  };
+
+  // Search order of a line's xdata, rebuilt when the buffer changes.
+  struct LineXOrder {
+    const double* xdata = nullptr;
+    int count = 0;
+    std::shared_ptr<const XOrder> order;
+  };
+
+  // Everything a static layer image depends on; a frame is current when its key
+  // matches the window's.
+  struct LayerKey {
+    QSize size;
+    QRect plot;
+    int dataSerial = -1;
+    int layerSerial = -1;
+    int viewStart = -1;
+    int viewLen = -1;
+    double yMin = 0.0;
+    double yMax = 0.0;
+    StereoDisplayMode stereoMode = StereoDisplayMode::SplitAxes;
+    bool workspaceActive = true;
+
+    bool operator==(const LayerKey& other) const;
+    bool operator!=(const LayerKey& other) const { return !(*this == other); }
+  };
+  // Lines of one axes on a transparent layer, kept so a pan can scroll them.
+  struct AxesTraces {
+    std::uint64_t axesId = 0;
+    QImage image;
+  };
+  struct LayerScene;
+
+  struct FftCacheEntry {
+    int dataSerial = -1;
+    int viewStart = -1;
+    int viewLen = -1;
+    int channel = -1;
+    std::vector<double> db;
+    std::uint64_t lastUse = 0;
+  };
+
+  void replaceData(const SignalData& data, SampleWindowProvider provider, int pagedDataLen);
+  int dataLength() const;
+  int timelineLength() const;
+  void ensurePage();
+  static bool pageMinMax(const SamplePage* page, int channel, int from, int to, double& vmin, double& vmax);
+  static double pageSample(const SamplePage* page, int channel, int index);
+  static bool isSourcedLine(const SignalData& data, bool paged, const GraphicsLineHandle& line);
+  static double sourceSample(const SignalData& data, bool paged, const SamplePage* page, int channel, int index);
+  static bool sourceMinMax(const SignalData& data,
+                           bool paged,
+                           const SamplePage* page,
+                           std::vector<SampleLod>& channelLods,
+                           int channel,
+                           int from,
+                           int to,
+                           double& vmin,
+                           double& vmax);
+  static const MinMaxPyramid* refreshLod(SampleLod& lod, const double* samples, int count);
+  static const MinMaxPyramid* linePyramid(std::unordered_map<std::uint64_t, SampleLod>& lods, const GraphicsLineHandle& line);
+  static const XOrder& lineXOrder(std::unordered_map<std::uint64_t, LineXOrder>& orders, const GraphicsLineHandle& line);
+  static QRect axesRectForPlot(const GraphicsAxesHandle& axes, const QRect& plot);
+  static void drawLine(LayerScene& scene,
+                       QPainter& p,
+                       const QRect& area,
+                       const GraphicsAxesHandle& axes,
+                       const GraphicsLineHandle& line,
+                       int columnFrom,
+                       int columnTo);
+  static QImage renderAxesTraces(LayerScene& scene, const GraphicsAxesHandle& axes, const QRect& axesRect);
+  static bool renderStaticLayer(LayerScene& scene, QImage& image);
   void cycleStereoMode();
   void applyRange(const Range& range, bool recordHistory = true);
   Range clampRange(const Range& range) const;
@@ -95,6 +200,7 @@ private:
   void panView(int direction);
   void togglePlayPause();
   void stopPlayback();
+  void showPlaybackError();
   void startPlaybackForRange(const Range& range);
   void startPlaybackFromSample(const Range& range, int startSample, bool startPaused);
   Range activePlaybackRange() const;
@@ -107,15 +213,27 @@ private:
   void updateYRange();
   void syncVisibleXRangeToAxes();
   void invalidateStaticLayer();
+  LayerKey currentLayerKey(const QRect& plot) const;
+  int staticLayerScrollColumns(const LayerKey& key, double& drift) const;
   void ensureStaticLayer(const QRect& plot);
+  void adoptStaticLayer(const LayerScene& scene, const QImage& image);
+  void drawStaticLayer(QPainter& p, const QRect& plot);
+  void cancelStaticLayerRender();
   int sampleToX(const QRect& plot, int sample) const;
   QRect plotRect() const;
   void updateHoverFromPoint(const QPoint& pt);
   QString formatTimeValue(int sample, bool withSuffix) const;
-  QString formatRmsInfo(const Range& range) const;
-  void drawStatusBar(QPainter& p) const;
+  QString formatRmsInfo(const Range& range);
+  bool pagedEnergyReady(int firstBlock, int lastBlock);
+  void fillPagedEnergy();
+  bool pagedRangeEnergy(int channel, int from, int to, double& sumSq) const;
+  void drawStatusBar(QPainter& p);
   void toggleFftOverlay();
   void ensureFftData();
+  void invalidateFftData();
+  void computePendingFft();
+  void adoptFftChannels(std::uint64_t generation, const std::vector<int>& channels, const std::vector<std::vector<double>>& db);
+  void cacheFftChannel(int channel, const std::vector<double>& db);
   void drawFftOverlays(QPainter& p, const QRect& plot);
   std::vector<FftPaneLayout> buildFftPaneLayouts(const QRect& plot, int nChannels) const;
   QPoint clampFftPaneOffset(const QRect& plot, const QPoint& desired, int channelIndex) const;
@@ -127,6 +245,34 @@ private:
   GraphicsFigureModel graphics_;
   bool workspaceActive_ = true;
 
+  // Paged mode: data_ only carries rate, timing and channel count; samples around the
+  // visible range are fetched through pageProvider_ as the view moves.
+  SampleWindowProvider pageProvider_;
+  int pagedDataLen_ = 0;
+  std::shared_ptr<const SamplePage> page_;
+  Range pagedRmsRange_{};
+  int pagedRmsSerial_ = -1;
+  QString pagedRmsText_;
+  // Energy of each kPagedEnergyBlock block per channel for pagedEnergySerial_. Blocks
+  // are fetched only once a status-bar range covers them: pagedEnergyTimer_ fills the
+  // missing blocks of pagedEnergyWanted_ (a block range) a slice per tick, and the
+  // readout shows a placeholder until they are all known.
+  struct PagedEnergy {
+    std::vector<double> blocks;
+    std::vector<char> known;
+  };
+  std::vector<PagedEnergy> pagedEnergy_;
+  int pagedEnergySerial_ = -1;
+  Range pagedEnergyWanted_{};
+  QTimer pagedEnergyTimer_;
+  // Energy index per channel over its stored samples, built on first use per data serial.
+  std::vector<EnergyIndex> channelEnergy_;
+  int channelEnergySerial_ = -1;
+
+  std::unordered_map<std::uint64_t, SampleLod> lineLods_;
+  std::unordered_map<std::uint64_t, LineXOrder> lineXOrders_;
+  std::vector<SampleLod> channelLods_;
+
   int viewStart_ = 0;
   int viewLen_ = 0;
   double yMin_ = -1.0;
@@ -150,6 +296,17 @@ private:
   int fftViewStart_ = -1;
   int fftViewLen_ = -1;
   int fftDataSerial_ = -1;
+  // fftDb_ is for the fftView*/fftDataSerial_ key once fftComputed_ is set; until
+  // then the channels in fftPendingChannels_ wait on fftComputeTimer_ or a job on
+  // renderPool_, and the overlay reads "computing...". Requests made while the timer
+  // waits only re-target it; a key change bumps fftGeneration_, which stops a running
+  // job. Spectra are kept per channel in a small LRU cache.
+  WelchOptions spectrumOptions_;
+  QTimer fftComputeTimer_;
+  std::vector<int> fftPendingChannels_;
+  std::atomic<std::uint64_t> fftGeneration_{0};
+  std::vector<FftCacheEntry> fftCache_;
+  std::uint64_t fftCacheTick_ = 0;
   std::vector<QPoint> fftPaneOffsets_;
   bool fftMovePending_ = false;
   bool fftMoveReady_ = false;
@@ -159,22 +316,26 @@ private:
   QTimer fftMoveHoldTimer_;
 
   QAudioSink* audioSink_ = nullptr;
-  QBuffer* audioBuffer_ = nullptr;
-  QByteArray pcmData_;
+  SignalPcmSource* audioSource_ = nullptr;
+  QString playbackError_;
   QTimer playheadTimer_;
   Range playingRange_{};
   std::vector<Range> rangeHistory_;
   int rangeHistoryIndex_ = -1;
 
-  QImage staticLayer_;
-  bool staticLayerValid_ = false;
-  QRect staticPlotRect_;
   int dataSerial_ = 0;
-  int cachedDataSerial_ = -1;
-  int cachedViewStart_ = -1;
-  int cachedViewLen_ = -1;
-  double cachedYMin_ = 0.0;
-  double cachedYMax_ = 0.0;
-  StereoDisplayMode cachedStereoDisplayMode_ = StereoDisplayMode::SplitAxes;
-  bool cachedWorkspaceActive_ = true;
+
+  // The static layer (grid, ticks, lines, texts) renders on renderPool_ from a
+  // LayerScene snapshot. staticLayer_ is the latest finished frame, which paint
+  // stretches onto the current view until the frame for pendingLayerKey_ arrives.
+  // A pan at unchanged zoom scrolls staticTraces_ by whole columns and draws only
+  // the exposed ones; staticTraceDrift_ is the sub-column error this has accumulated.
+  QImage staticLayer_;
+  LayerKey staticLayerKey_;
+  std::vector<AxesTraces> staticTraces_;
+  double staticTraceDrift_ = 0.0;
+  std::optional<LayerKey> pendingLayerKey_;
+  int layerSerial_ = 0;
+  std::atomic<std::uint64_t> renderGeneration_{0};
+  QThreadPool renderPool_;
 };
@@ -0,0 +1,440 @@
+#include "SignalKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+constexpr size_t kLanes = 8;
+
+template <typename T>
+double sumOfSquaresImpl(const T* samples, size_t count) {
+  if (!samples || count == 0) {
+    return 0.0;
+  }
+
+  double lanes[kLanes] = {};
+  size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes) {
+    for (size_t k = 0; k < kLanes; ++k) {
+      const double v = samples[i + k];
+      lanes[k] += v * v;
+    }
+  }
+  double tail = 0.0;
+  for (; i < count; ++i) {
+    const double v = samples[i];
+    tail += v * v;
+  }
+
+  double sum = tail;
+  for (size_t k = 0; k < kLanes; ++k) {
+    sum += lanes[k];
+  }
+  return sum;
+}
+
+template <typename T>
+void accumulateMinMaxImpl(const T* samples, size_t count, double& minOut, double& maxOut) {
+  if (!samples || count == 0) {
+    return;
+  }
+
+  T lo[kLanes];
+  T hi[kLanes];
+  for (size_t k = 0; k < kLanes; ++k) {
+    lo[k] = std::numeric_limits<T>::infinity();
+    hi[k] = -std::numeric_limits<T>::infinity();
+  }
+  size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes) {
+    for (size_t k = 0; k < kLanes; ++k) {
+      const T v = samples[i + k];
+      // Written so a NaN sample keeps the running value (maps onto minpd/maxpd).
+      lo[k] = v < lo[k] ? v : lo[k];
+      hi[k] = v > hi[k] ? v : hi[k];
+    }
+  }
+  for (; i < count; ++i) {
+    const T v = samples[i];
+    lo[0] = v < lo[0] ? v : lo[0];
+    hi[0] = v > hi[0] ? v : hi[0];
+  }
+
+  for (size_t k = 0; k < kLanes; ++k) {
+    minOut = lo[k] < minOut ? lo[k] : minOut;
+    maxOut = hi[k] > maxOut ? hi[k] : maxOut;
+  }
+}
+
+void foldBlocks(const std::vector<double>& level, size_t first, size_t last, double& minOut, double& maxOut) {
+  for (size_t b = first; b < last; ++b) {
+    minOut = level[2 * b] < minOut ? level[2 * b] : minOut;
+    maxOut = level[2 * b + 1] > maxOut ? level[2 * b + 1] : maxOut;
+  }
+}
+
+template <typename T>
+MinMaxPyramid buildMinMaxPyramidImpl(const T* samples, size_t count) {
+  MinMaxPyramid pyramid;
+  pyramid.count = count;
+  if (!samples || count < 4 * kMinMaxBaseBlock) {
+    return pyramid;
+  }
+
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> base(2 * ((count + kMinMaxBaseBlock - 1) / kMinMaxBaseBlock));
+  for (size_t b = 0, start = 0; start < count; ++b, start += kMinMaxBaseBlock) {
+    double lo = inf;
+    double hi = -inf;
+    accumulateMinMaxImpl(samples + start, std::min(kMinMaxBaseBlock, count - start), lo, hi);
+    base[2 * b] = lo;
+    base[2 * b + 1] = hi;
+  }
+  pyramid.levels.push_back(std::move(base));
+
+  while (pyramid.levels.back().size() / 2 > kMinMaxFanout) {
+    const std::vector<double>& below = pyramid.levels.back();
+    const size_t belowBlocks = below.size() / 2;
+    std::vector<double> level(2 * ((belowBlocks + kMinMaxFanout - 1) / kMinMaxFanout));
+    for (size_t b = 0, first = 0; first < belowBlocks; ++b, first += kMinMaxFanout) {
+      double lo = inf;
+      double hi = -inf;
+      foldBlocks(below, first, std::min(first + kMinMaxFanout, belowBlocks), lo, hi);
+      level[2 * b] = lo;
+      level[2 * b + 1] = hi;
+    }
+    pyramid.levels.push_back(std::move(level));
+  }
+  return pyramid;
+}
+
+template <typename T>
+void pyramidMinMaxImpl(const MinMaxPyramid& pyramid,
+                       const T* samples,
+                       size_t from,
+                       size_t to,
+                       double& minOut,
+                       double& maxOut) {
+  to = std::min(to, pyramid.count);
+  if (!samples || from >= to) {
+    return;
+  }
+
+  // Whole base blocks inside the range go through the pyramid; the ragged ends are
+  // scanned directly.
+  size_t lo = (from + kMinMaxBaseBlock - 1) / kMinMaxBaseBlock;
+  size_t hi = to / kMinMaxBaseBlock;
+  if (pyramid.levels.empty() || lo >= hi) {
+    accumulateMinMaxImpl(samples + from, to - from, minOut, maxOut);
+    return;
+  }
+  accumulateMinMaxImpl(samples + from, lo * kMinMaxBaseBlock - from, minOut, maxOut);
+  accumulateMinMaxImpl(samples + hi * kMinMaxBaseBlock, to - hi * kMinMaxBaseBlock, minOut, maxOut);
+
+  for (size_t levelIndex = 0; lo < hi; ++levelIndex) {
+    const std::vector<double>& level = pyramid.levels[levelIndex];
+    const size_t upLo = (lo + kMinMaxFanout - 1) / kMinMaxFanout;
+    const size_t upHi = hi / kMinMaxFanout;
+    if (levelIndex + 1 == pyramid.levels.size() || upLo >= upHi) {
+      foldBlocks(level, lo, hi, minOut, maxOut);
+      return;
+    }
+    foldBlocks(level, lo, upLo * kMinMaxFanout, minOut, maxOut);
+    foldBlocks(level, upHi * kMinMaxFanout, hi, minOut, maxOut);
+    lo = upLo;
+    hi = upHi;
+  }
+}
+template <typename T>
+EnergyIndex buildEnergyIndexImpl(const T* samples, size_t count) {
+  EnergyIndex index;
+  index.count = count;
+  const size_t blocks = count / kEnergyBlock;
+  index.hi.assign(blocks + 1, 0.0);
+  index.lo.assign(blocks + 1, 0.0);
+  EnergySum sum;
+  for (size_t b = 0; b < blocks; ++b) {
+    addEnergy(sum, sumOfSquaresImpl(samples + b * kEnergyBlock, kEnergyBlock));
+    index.hi[b + 1] = sum.hi;
+    index.lo[b + 1] = sum.lo;
+  }
+  return index;
+}
+
+template <typename T>
+double rangeEnergyImpl(const EnergyIndex& index, const T* samples, size_t from, size_t to) {
+  to = std::min(to, index.count);
+  if (!samples || from >= to) {
+    return 0.0;
+  }
+  const size_t firstBlock = (from + kEnergyBlock - 1) / kEnergyBlock;
+  const size_t lastBlock = to / kEnergyBlock;
+  if (firstBlock >= lastBlock) {
+    return sumOfSquaresImpl(samples + from, to - from);
+  }
+  const double whole = (index.hi[lastBlock] - index.hi[firstBlock]) + (index.lo[lastBlock] - index.lo[firstBlock]);
+  return sumOfSquaresImpl(samples + from, firstBlock * kEnergyBlock - from) + whole +
+         sumOfSquaresImpl(samples + lastBlock * kEnergyBlock, to - lastBlock * kEnergyBlock);
+}
+
+// In-place iterative radix-2 FFT; data.size() must be a power of two.
+void fftInPlace(std::vector<std::complex<double>>& data) {
+  const size_t n = data.size();
+  for (size_t i = 1, j = 0; i < n; ++i) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      std::swap(data[i], data[j]);
+    }
+  }
+  const double pi = std::acos(-1.0);
+  for (size_t len = 2; len <= n; len <<= 1) {
+    const std::complex<double> step = std::polar(1.0, -2.0 * pi / static_cast<double>(len));
+    for (size_t i = 0; i < n; i += len) {
+      std::complex<double> w(1.0, 0.0);
+      for (size_t k = 0; k < len / 2; ++k) {
+        const std::complex<double> u = data[i + k];
+        const std::complex<double> v = data[i + k + len / 2] * w;
+        data[i + k] = u + v;
+        data[i + k + len / 2] = u - v;
+        w *= step;
+      }
+    }
+  }
+}
+
+template <typename T, bool Clamp, typename Out>
+inline Out pcmToSample(T sample, Out offset, Out scale) {
+  Out v = (static_cast<Out>(sample) + offset) * scale;
+  if (Clamp) {
+    v = v < Out(-1) ? Out(-1) : v;
+    v = v > Out(1) ? Out(1) : v;
+  }
+  return v;
+}
+
+// Capture buffers carry no alignment guarantee, so samples are copied into a typed
+// chunk first; the lane loop then reads a local array that cannot alias `out`.
+template <typename T, bool Clamp, typename Out>
+void decodePcmImpl(const unsigned char* data, size_t count, Out offset, Out scale, Out* out) {
+  constexpr size_t kChunk = 256;
+  T chunk[kChunk];
+  for (size_t base = 0; base < count; base += kChunk) {
+    const size_t n = std::min(kChunk, count - base);
+    std::memcpy(chunk, data + base * sizeof(T), n * sizeof(T));
+    Out* dst = out + base;
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+      for (size_t k = 0; k < kLanes; ++k) {
+        dst[i + k] = pcmToSample<T, Clamp>(chunk[i + k], offset, scale);
+      }
+    }
+    for (; i < n; ++i) {
+      dst[i] = pcmToSample<T, Clamp>(chunk[i], offset, scale);
+    }
+  }
+}
+
+template <typename Out>
+void decodePcmAs(PcmFormat format, const void* data, size_t count, Out* out) {
+  if (!data || !out || count == 0) {
+    return;
+  }
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  switch (format) {
+    case PcmFormat::UInt8:
+      decodePcmImpl<std::uint8_t, false>(bytes, count, Out(-128), Out(1) / Out(128), out);
+      return;
+    case PcmFormat::Int16:
+      decodePcmImpl<std::int16_t, false>(bytes, count, Out(0), Out(1) / Out(32768), out);
+      return;
+    case PcmFormat::Int32:
+      decodePcmImpl<std::int32_t, false>(bytes, count, Out(0), Out(1) / Out(2147483648.0), out);
+      return;
+    case PcmFormat::Float:
+      decodePcmImpl<float, true>(bytes, count, Out(0), Out(1), out);
+      return;
+  }
+}
+
+}  // namespace
+
+double sumOfSquares(const double* samples, size_t count) {
+  return sumOfSquaresImpl(samples, count);
+}
+
+void accumulateMinMax(const double* samples, size_t count, double& minOut, double& maxOut) {
+  accumulateMinMaxImpl(samples, count, minOut, maxOut);
+}
+
+MinMaxPyramid buildMinMaxPyramid(const double* samples, size_t count) {
+  return buildMinMaxPyramidImpl(samples, count);
+}
+
+void pyramidMinMax(const MinMaxPyramid& pyramid,
+                   const double* samples,
+                   size_t from,
+                   size_t to,
+                   double& minOut,
+                   double& maxOut) {
+  pyramidMinMaxImpl(pyramid, samples, from, to, minOut, maxOut);
+}
+
+void addEnergy(EnergySum& sum, double value) {
+  // TwoSum: hi + lo stays the exact running total up to the rounding of each value.
+  const double total = sum.hi + value;
+  const double valuePart = total - sum.hi;
+  sum.lo += (sum.hi - (total - valuePart)) + (value - valuePart);
+  sum.hi = total;
+}
+
+EnergyIndex buildEnergyIndex(const double* samples, size_t count) {
+  return buildEnergyIndexImpl(samples, count);
+}
+
+double rangeEnergy(const EnergyIndex& index, const double* samples, size_t from, size_t to) {
+  return rangeEnergyImpl(index, samples, from, to);
+}
+
+XOrder buildXOrder(const double* x, size_t count) {
+  XOrder out;
+  for (size_t i = 0; i < count && out.sorted; ++i) {
+    out.sorted = !std::isnan(x[i]) && (i == 0 || x[i - 1] <= x[i]);
+  }
+  if (out.sorted) {
+    return out;
+  }
+  out.order.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (!std::isnan(x[i])) {
+      out.order.push_back(static_cast<int>(i));
+    }
+  }
+  std::stable_sort(out.order.begin(), out.order.end(), [x](int a, int b) { return x[a] < x[b]; });
+  return out;
+}
+
+WelchSpectrum makeWelchSpectrum(size_t segmentSize, SpectrumWindow window) {
+  WelchSpectrum out;
+  out.window.resize(segmentSize, 1.0);
+  const double pi = std::acos(-1.0);
+  for (size_t i = 0; i < segmentSize && segmentSize > 1; ++i) {
+    const double phase = 2.0 * pi * static_cast<double>(i) / static_cast<double>(segmentSize);
+    if (window == SpectrumWindow::Hann) {
+      out.window[i] = 0.5 - 0.5 * std::cos(phase);
+    } else if (window == SpectrumWindow::Hamming) {
+      out.window[i] = 0.54 - 0.46 * std::cos(phase);
+    }
+  }
+  out.power.assign(segmentSize / 2 + 1, 0.0);
+  return out;
+}
+
+void addWelchSegment(WelchSpectrum& spectrum, const double* samples) {
+  const size_t n = spectrum.window.size();
+  std::vector<std::complex<double>> data(n);
+  for (size_t i = 0; i < n; ++i) {
+    const double v = std::isnan(samples[i]) ? 0.0 : samples[i];
+    data[i] = std::complex<double>(v * spectrum.window[i], 0.0);
+  }
+  fftInPlace(data);
+  for (size_t k = 0; k < spectrum.power.size(); ++k) {
+    spectrum.power[k] += std::norm(data[k]);
+  }
+  ++spectrum.segments;
+}
+
+std::vector<double> welchPowerDb(const WelchSpectrum& spectrum) {
+  std::vector<double> out(spectrum.power.size(), -200.0);
+  double windowSum = 0.0;
+  for (double w : spectrum.window) {
+    windowSum += w;
+  }
+  if (spectrum.segments == 0 || windowSum <= 0.0) {
+    return out;
+  }
+  // One-sided amplitude scaling: a sine of amplitude A peaks at A^2.
+  const size_t nyquist = spectrum.window.size() / 2;
+  for (size_t k = 0; k < out.size(); ++k) {
+    const double scale = (k == 0 || k == nyquist) ? 1.0 : 2.0;
+    const double amplitude2 = spectrum.power[k] / static_cast<double>(spectrum.segments) * (scale / windowSum) * (scale / windowSum);
+    out[k] = 10.0 * std::log10(std::max(amplitude2, 1e-20));
+  }
+  return out;
+}
+
+WelchPlan planWelchSegments(int start, int length, const WelchOptions& options) {
+  WelchPlan plan;
+  int segment = 16;
+  while (segment * 2 <= std::min(std::max(16, options.segmentSize), length)) {
+    segment *= 2;
+  }
+  plan.segmentSize = segment;
+  if (length < segment) {
+    return plan;
+  }
+
+  const int hop = std::max(1, static_cast<int>(std::llround(segment * (1.0 - std::clamp(options.overlap, 0.0, 0.95)))));
+  const int maxSegments = std::max(1, options.maxSegments);
+  const int fullCount = (length - segment) / hop + 1;
+  if (fullCount <= maxSegments) {
+    for (int i = 0; i < fullCount; ++i) {
+      plan.starts.push_back(start + i * hop);
+    }
+  } else {
+    for (int i = 0; i < maxSegments; ++i) {
+      const long long spread = static_cast<long long>(length - segment) * i / std::max(1, maxSegments - 1);
+      plan.starts.push_back(start + static_cast<int>(spread));
+    }
+  }
+  return plan;
+}
+
+void decodePcm(PcmFormat format, const void* data, size_t count, float* out) {
+  decodePcmAs(format, data, count, out);
+}
+
+void decodePcm(PcmFormat format, const void* data, size_t count, double* out) {
+  decodePcmAs(format, data, count, out);
+}
+
+void remixInterleaved(const float* in, size_t frames, int inChannels, int outChannels, float* out) {
+  if (!in || !out || frames == 0 || inChannels <= 0 || outChannels <= 0) {
+    return;
+  }
+  const size_t inCh = static_cast<size_t>(inChannels);
+  const size_t outCh = static_cast<size_t>(outChannels);
+  if (inCh == outCh) {
+    std::memcpy(out, in, frames * inCh * sizeof(float));
+    return;
+  }
+  if (outCh == 1) {
+    const float scale = 1.0f / static_cast<float>(inCh);
+    if (inCh == 2) {
+      for (size_t f = 0; f < frames; ++f) {
+        out[f] = (in[2 * f] + in[2 * f + 1]) * scale;
+      }
+      return;
+    }
+    for (size_t f = 0; f < frames; ++f) {
+      float sum = 0.0f;
+      for (size_t ch = 0; ch < inCh; ++ch) {
+        sum += in[f * inCh + ch];
+      }
+      out[f] = sum * scale;
+    }
+    return;
+  }
+  for (size_t f = 0; f < frames; ++f) {
+    for (size_t ch = 0; ch < outCh; ++ch) {
+      out[f * outCh + ch] = in[f * inCh + std::min(ch, inCh - 1)];
+    }
+  }
+}
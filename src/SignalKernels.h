@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Tight numeric loops shared by the facade and the signal windows. They are
+// written with independent accumulator lanes so the compiler can keep them in
+// vector registers without -ffast-math.
+
+double sumOfSquares(const double* samples, size_t count);
+
+// Folds the samples into [minOut, maxOut]; NaN samples are skipped. Callers seed
+// the bounds with +inf/-inf (or a running range).
+void accumulateMinMax(const double* samples, size_t count, double& minOut, double& maxOut);
+
+// Block min/max summary of a sample array. Level 0 holds one (min, max) pair per
+// kMinMaxBaseBlock samples and each further level folds kMinMaxFanout blocks of the
+// level below, so a range query touches O(base + fanout * levels) values instead of
+// every sample. Blocks without a finite sample hold (+inf, -inf).
+constexpr size_t kMinMaxBaseBlock = 64;
+constexpr size_t kMinMaxFanout = 8;
+
+struct MinMaxPyramid {
+  size_t count = 0;
+  std::vector<std::vector<double>> levels;
+};
+
+// Arrays shorter than a few base blocks get an empty pyramid; queries then scan.
+MinMaxPyramid buildMinMaxPyramid(const double* samples, size_t count);
+
+// Same contract as accumulateMinMax() for samples[from, to), where `samples` is the
+// array the pyramid was built over.
+void pyramidMinMax(const MinMaxPyramid& pyramid,
+                   const double* samples,
+                   size_t from,
+                   size_t to,
+                   double& minOut,
+                   double& maxOut);
+
+// Prefix sums of squares at every kEnergyBlock samples, so the energy of any range
+// costs two table lookups plus at most two partial blocks. Each prefix is kept as an
+// unevaluated sum hi + lo so long arrays do not lose the energy of quiet ranges.
+constexpr size_t kEnergyBlock = 256;
+
+struct EnergyIndex {
+  size_t count = 0;
+  std::vector<double> hi;
+  std::vector<double> lo;
+};
+
+EnergyIndex buildEnergyIndex(const double* samples, size_t count);
+
+// Running total in the same hi + lo form, for energies gathered piece by piece (e.g.
+// blocks streamed from the engine). Each add loses only the rounding of `value`.
+struct EnergySum {
+  double hi = 0.0;
+  double lo = 0.0;
+};
+
+void addEnergy(EnergySum& sum, double value);
+inline double energyTotal(const EnergySum& sum) { return sum.hi + sum.lo; }
+
+// Sum of squares of samples[from, to), where `samples` is the indexed array.
+double rangeEnergy(const EnergyIndex& index, const double* samples, size_t from, size_t to);
+
+// Search order of an x array for bin queries. A non-decreasing array without NaN is
+// `sorted` and searched in place; otherwise `order` lists the indices of its non-NaN
+// values by ascending x (ties keep index order).
+struct XOrder {
+  bool sorted = true;
+  std::vector<int> order;
+};
+
+XOrder buildXOrder(const double* x, size_t count);
+
+// Averaged-periodogram (Welch) spectrum. Segments of a fixed power-of-two size are
+// windowed, transformed and their power summed; the FFT size never depends on how
+// many samples are analyzed.
+enum class SpectrumWindow {
+  Rectangular,
+  Hann,
+  Hamming,
+};
+
+struct WelchOptions {
+  int segmentSize = 4096;
+  double overlap = 0.5;
+  SpectrumWindow window = SpectrumWindow::Hann;
+  // Longer ranges analyze this many segments spread evenly over the range.
+  int maxSegments = 64;
+};
+
+struct WelchSpectrum {
+  std::vector<double> window;
+  std::vector<double> power;
+  size_t segments = 0;
+};
+
+// `segmentSize` must be a power of two.
+WelchSpectrum makeWelchSpectrum(size_t segmentSize, SpectrumWindow window);
+// Adds one segment of window.size() samples; NaN samples count as silence.
+void addWelchSegment(WelchSpectrum& spectrum, const double* samples);
+// segmentSize / 2 + 1 bins from DC to Nyquist, in dB relative to a full-scale sine.
+std::vector<double> welchPowerDb(const WelchSpectrum& spectrum);
+
+// Segments analyzed for `length` samples from `start`. Ranges shorter than the
+// configured size use the largest power of two (at least 16) that fits; `starts` is
+// empty when even that does not.
+struct WelchPlan {
+  int segmentSize = 0;
+  std::vector<int> starts;
+};
+
+WelchPlan planWelchSegments(int start, int length, const WelchOptions& options);
+
+// Capture sample formats (native byte order), mirroring QAudioFormat's.
+enum class PcmFormat {
+  UInt8,
+  Int16,
+  Int32,
+  Float,
+};
+
+// Decodes `count` packed samples to [-1, 1] (Float input is clamped). The format is
+// dispatched once per call; each loop is a plain load-scale-store the compiler
+// vectorizes. The double flavor keeps Int32 input exact and, with PcmFormat::Float,
+// widens converter output into the engine's sample type.
+void decodePcm(PcmFormat format, const void* data, size_t count, float* out);
+void decodePcm(PcmFormat format, const void* data, size_t count, double* out);
+
+// Maps `frames` interleaved frames from inChannels to outChannels: mono output
+// averages the input channels, otherwise output channel k copies input channel k
+// (the last one when there are fewer). `in` and `out` must not overlap. There is no
+// planar variant: the resampler, record results and async blocks all take
+// interleaved frames.
+void remixInterleaved(const float* in, size_t frames, int inChannels, int outChannels, float* out);
@@ -53,7 +53,7 @@ void SignalTableWindow::fillTable(const SignalData& data) {
 
   size_t maxLen = 0;
   for (const auto& ch : data.channels) {
-    maxLen = std::max(maxLen, ch.samples.size());
+    maxLen = std::max(maxLen, static_cast<size_t>(channelLength(ch)));
   }
 
   const int maxRows = static_cast<int>(std::min<size_t>(maxLen, 5000));
@@ -71,8 +71,9 @@ void SignalTableWindow::fillTable(const SignalData& data) {
     table_->setItem(r, 0, new QTableWidgetItem(QString::number(r)));
     for (int c = 0; c < channels; ++c) {
       QString text;
-      if (static_cast<size_t>(r) < data.channels[static_cast<size_t>(c)].samples.size()) {
-        text = QString::number(data.channels[static_cast<size_t>(c)].samples[static_cast<size_t>(r)], 'g', 8);
+      const auto& ch = data.channels[static_cast<size_t>(c)];
+      if (r < channelLength(ch)) {
+        text = QString::number(channelSample(ch, r), 'g', 8);
       }
       table_->setItem(r, c + 1, new QTableWidgetItem(text));
     }
@@ -2,7 +2,16 @@
 
 #include <QApplication>
 
+namespace {
+// Qt diagnostics go to the terminal, never into the captured output of a command that
+// happens to be running on the eval thread.
+void writeQtMessage(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+  AuxEngineFacade::writeUncaptured(qFormatLogMessage(type, context, message).toStdString() + "\n");
+}
+}  // namespace
+
 int main(int argc, char* argv[]) {
+  qInstallMessageHandler(writeQtMessage);
   QApplication app(argc, argv);
 
   MainWindow w;
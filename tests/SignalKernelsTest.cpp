@@ -0,0 +1,277 @@
+#include "SignalKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+int failures = 0;
+
+void check(bool ok, const char* what, int line) {
+  if (!ok) {
+    std::fprintf(stderr, "FAILED (line %d): %s\n", line, what);
+    ++failures;
+  }
+}
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+bool near(double a, double b, double tol) {
+  return std::fabs(a - b) <= tol;
+}
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::vector<double> noise(size_t count, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<double> out(count);
+  for (double& v : out) {
+    v = dist(rng);
+  }
+  return out;
+}
+
+void testSumOfSquares() {
+  // RMS of a full-scale sine is 1/sqrt(2).
+  const size_t n = 4096;
+  std::vector<double> sine(n);
+  for (size_t i = 0; i < n; ++i) {
+    sine[i] = std::sin(2.0 * kPi * 64.0 * static_cast<double>(i) / static_cast<double>(n));
+  }
+  CHECK(near(std::sqrt(sumOfSquares(sine.data(), n) / static_cast<double>(n)), std::sqrt(0.5), 1e-9));
+
+  // Every tail length behind the accumulator lanes.
+  const std::vector<double> samples = noise(1000, 5);
+  bool same = true;
+  for (size_t count = 0; count < 40; ++count) {
+    long double ref = 0.0L;
+    for (size_t i = 0; i < count; ++i) {
+      ref += static_cast<long double>(samples[i]) * samples[i];
+    }
+    same = same && near(sumOfSquares(samples.data(), count), static_cast<double>(ref), 1e-12);
+  }
+  CHECK(same);
+
+  const double total = sumOfSquares(samples.data(), samples.size());
+  long double ref = 0.0L;
+  for (double v : samples) {
+    ref += static_cast<long double>(v) * v;
+  }
+  CHECK(near(total, static_cast<double>(ref), 1e-12 * total));
+}
+
+void testPyramidMatchesScan() {
+  std::vector<double> samples = noise(50000, 1);
+  samples[777] = std::numeric_limits<double>::quiet_NaN();
+  samples[31000] = 5.0;
+  const MinMaxPyramid pyramid = buildMinMaxPyramid(samples.data(), samples.size());
+  CHECK(!pyramid.levels.empty());
+
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<size_t> pick(0, samples.size());
+  bool same = true;
+  for (int trial = 0; trial < 500; ++trial) {
+    size_t from = pick(rng);
+    size_t to = pick(rng);
+    if (from > to) {
+      std::swap(from, to);
+    }
+    double refMin = std::numeric_limits<double>::infinity();
+    double refMax = -std::numeric_limits<double>::infinity();
+    for (size_t i = from; i < to; ++i) {
+      if (!std::isnan(samples[i])) {
+        refMin = std::min(refMin, samples[i]);
+        refMax = std::max(refMax, samples[i]);
+      }
+    }
+    double minOut = std::numeric_limits<double>::infinity();
+    double maxOut = -std::numeric_limits<double>::infinity();
+    pyramidMinMax(pyramid, samples.data(), from, to, minOut, maxOut);
+    same = same && minOut == refMin && maxOut == refMax;
+  }
+  CHECK(same);
+}
+
+void testWelchFullScaleSine() {
+  const size_t n = 4096;
+  const double bin = 64.0;
+  std::vector<double> sine(n);
+  for (size_t i = 0; i < n; ++i) {
+    sine[i] = std::sin(2.0 * kPi * bin * static_cast<double>(i) / static_cast<double>(n));
+  }
+
+  for (SpectrumWindow window : {SpectrumWindow::Rectangular, SpectrumWindow::Hann, SpectrumWindow::Hamming}) {
+    WelchSpectrum spectrum = makeWelchSpectrum(n, window);
+    addWelchSegment(spectrum, sine.data());
+    addWelchSegment(spectrum, sine.data());
+    const std::vector<double> db = welchPowerDb(spectrum);
+    CHECK(db.size() == n / 2 + 1);
+    const auto peak = std::max_element(db.begin(), db.end());
+    CHECK(static_cast<size_t>(peak - db.begin()) == static_cast<size_t>(bin));
+    CHECK(near(*peak, 0.0, 0.01));
+  }
+}
+
+void testWelchPlan() {
+  WelchOptions options;
+  options.segmentSize = 1024;
+  options.overlap = 0.5;
+  options.maxSegments = 4;
+
+  // Three half-overlapping segments fit exactly.
+  WelchPlan plan = planWelchSegments(100, 2048, options);
+  CHECK(plan.segmentSize == 1024);
+  CHECK((plan.starts == std::vector<int>{100, 612, 1124}));
+
+  // More would fit than allowed: the allowed ones spread from start to end.
+  plan = planWelchSegments(0, 10240, options);
+  CHECK((plan.starts == std::vector<int>{0, 3072, 6144, 9216}));
+
+  // A short range shrinks the segment to the largest power of two that fits.
+  plan = planWelchSegments(0, 300, options);
+  CHECK(plan.segmentSize == 256);
+  CHECK(plan.starts.size() == 1);
+
+  plan = planWelchSegments(0, 10, options);
+  CHECK(plan.starts.empty());
+}
+
+void testEnergyMatchesNaiveSum() {
+  std::vector<double> samples = noise(100000, 3);
+  // A loud burst and a quiet tail 120 dB apart: the tail must keep its energy.
+  for (size_t i = 0; i < 1000; ++i) {
+    samples[i] *= 1e3;
+  }
+  for (size_t i = 90000; i < samples.size(); ++i) {
+    samples[i] *= 1e-3;
+  }
+  const EnergyIndex index = buildEnergyIndex(samples.data(), samples.size());
+
+  std::mt19937 rng(4);
+  std::uniform_int_distribution<size_t> pick(0, samples.size());
+  bool same = true;
+  for (int trial = 0; trial < 500; ++trial) {
+    size_t from = pick(rng);
+    size_t to = pick(rng);
+    if (from > to) {
+      std::swap(from, to);
+    }
+    long double ref = 0.0L;
+    for (size_t i = from; i < to; ++i) {
+      ref += static_cast<long double>(samples[i]) * samples[i];
+    }
+    const double got = rangeEnergy(index, samples.data(), from, to);
+    same = same && std::fabs(got - static_cast<double>(ref)) <= 1e-9 * static_cast<double>(ref);
+  }
+  CHECK(same);
+
+  const double tail = rangeEnergy(index, samples.data(), 90000, samples.size());
+  CHECK(tail > 0.0);
+  CHECK(near(tail, sumOfSquares(samples.data() + 90000, samples.size() - 90000), 1e-9 * tail));
+}
+
+void testEnergySum() {
+  // A plain double total would drop every one of the small additions.
+  EnergySum sum;
+  double plain = 0.0;
+  addEnergy(sum, 1e16);
+  plain += 1e16;
+  for (int i = 0; i < 1000; ++i) {
+    addEnergy(sum, 1.0);
+    plain += 1.0;
+  }
+  CHECK(plain == 1e16);
+  CHECK(energyTotal(sum) == 1e16 + 1000.0);
+}
+
+void testDecodeEdges() {
+  const std::uint8_t u8[] = {0, 128, 255};
+  float out8[3] = {};
+  decodePcm(PcmFormat::UInt8, u8, 3, out8);
+  CHECK(out8[0] == -1.0f);
+  CHECK(out8[1] == 0.0f);
+  CHECK(near(out8[2], 127.0 / 128.0, 1e-7));
+
+  const std::int16_t i16[] = {-32768, 0, 32767};
+  float out16[3] = {};
+  decodePcm(PcmFormat::Int16, i16, 3, out16);
+  CHECK(out16[0] == -1.0f);
+  CHECK(out16[1] == 0.0f);
+  CHECK(near(out16[2], 32767.0 / 32768.0, 1e-7));
+
+  const std::int32_t i32[] = {std::numeric_limits<std::int32_t>::min(), 0, std::numeric_limits<std::int32_t>::max()};
+  float out32[3] = {};
+  decodePcm(PcmFormat::Int32, i32, 3, out32);
+  CHECK(out32[0] == -1.0f);
+  CHECK(out32[1] == 0.0f);
+  CHECK(out32[2] <= 1.0f && out32[2] > 0.9999f);
+
+  const float f[] = {-2.0f, 0.25f, 2.0f};
+  float outF[3] = {};
+  decodePcm(PcmFormat::Float, f, 3, outF);
+  CHECK(outF[0] == -1.0f);
+  CHECK(outF[1] == 0.25f);
+  CHECK(outF[2] == 1.0f);
+
+  // Longer than one decode chunk, starting at an odd byte offset.
+  std::vector<unsigned char> raw(1 + 1000 * sizeof(std::int16_t));
+  std::vector<std::int16_t> ref(1000);
+  for (size_t i = 0; i < ref.size(); ++i) {
+    ref[i] = static_cast<std::int16_t>(static_cast<int>(i * 97) - 32768);
+  }
+  std::copy_n(reinterpret_cast<const unsigned char*>(ref.data()), ref.size() * sizeof(std::int16_t), raw.begin() + 1);
+  std::vector<float> decoded(ref.size());
+  decodePcm(PcmFormat::Int16, raw.data() + 1, ref.size(), decoded.data());
+  bool same = true;
+  for (size_t i = 0; i < ref.size(); ++i) {
+    same = same && decoded[i] == static_cast<float>(ref[i]) / 32768.0f;
+  }
+  CHECK(same);
+
+  // Double output keeps every Int32 step and clamps converter output like the float one.
+  const std::int32_t i32Step[] = {1, -3};
+  double outStep[2] = {};
+  decodePcm(PcmFormat::Int32, i32Step, 2, outStep);
+  CHECK(outStep[0] == 1.0 / 2147483648.0);
+  CHECK(outStep[1] == -3.0 / 2147483648.0);
+
+  double outD[3] = {};
+  decodePcm(PcmFormat::Float, f, 3, outD);
+  CHECK(outD[0] == -1.0);
+  CHECK(outD[1] == 0.25);
+  CHECK(outD[2] == 1.0);
+}
+
+void testRemix() {
+  const float stereo[] = {1.0f, -1.0f, 0.5f, 0.25f};
+  float mono[2] = {};
+  remixInterleaved(stereo, 2, 2, 1, mono);
+  CHECK(mono[0] == 0.0f);
+  CHECK(mono[1] == 0.375f);
+
+  const float single[] = {0.1f, 0.2f};
+  float dual[4] = {};
+  remixInterleaved(single, 2, 1, 2, dual);
+  CHECK(dual[0] == 0.1f && dual[1] == 0.1f && dual[2] == 0.2f && dual[3] == 0.2f);
+}
+}  // namespace
+
+int main() {
+  testSumOfSquares();
+  testPyramidMatchesScan();
+  testWelchFullScaleSine();
+  testWelchPlan();
+  testEnergyMatchesNaiveSum();
+  testEnergySum();
+  testDecodeEdges();
+  testRemix();
+  if (failures == 0) {
+    std::printf("SignalKernels: all checks passed\n");
+  }
+  return failures == 0 ? 0 : 1;
+}